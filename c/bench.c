@@ -0,0 +1,376 @@
+/*
+  This file is part of ethash.
+
+  ethash is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  ethash is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with ethash.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file bench.c
+* @date 2026
+*
+* Throughput and latency of the CPU implementation, printed as one JSON
+* object: Keccak ns/op, cache and DAG generation time, ethash_hash and
+* ethash_hash_batch hashes/s on one and on all threads, the batch rate on
+* 4 KB pages against huge pages, light verification
+* latency percentiles, and the partial DAG's hash rate at several resident
+* fractions. Runs on a small synthetic DAG by
+* default, and additionally on a full epoch DAG with -b. With --selftest it
+* runs ethash_self_test and ethash_verify_self_test instead and exits
+* with their verdict.
+*
+*   gcc -O2 -pthread bench.c ethash.c dag_alloc.c selftest.c verify.c -o bench
+*/
+
+#define _GNU_SOURCE
+#include <getopt.h>
+#include <pthread.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <time.h>
+#include <unistd.h>
+#include "ethash.h"
+#include "ethash_core.h"
+#include "dag_alloc.h"
+#include "verify.h"
+
+typedef struct bench_config {
+    double seconds;                 // per throughput case
+    unsigned threads;
+    unsigned samples;               // light verifications timed
+} bench_config;
+
+static int first_result = 1;
+
+static double now(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec + ts.tv_nsec * 1e-9;
+}
+
+// Opens a result object; the caller prints its fields and closes it with "}".
+static void result_begin(char const *name, char const *dataset) {
+    printf("%s\n    {\"name\": \"%s\", \"dataset\": \"%s\"", first_result ? "" : ",", name, dataset);
+    first_result = 0;
+}
+
+// The single-block hashes of ethash_core.h, called directly so they are
+// inlined as in the hash loop.
+static void bench_keccak(bench_config const *config) {
+    static char const *const names[] = {
+        "sha3_512_40",              // header || nonce
+        "sha3_512_64",              // cache and dataset items
+        "sha3_256_96",              // seed || compressed mix
+    };
+    uint64_t in[12] = {0};
+    uint64_t out[8];
+    for (unsigned c = 0; c != sizeof(names) / sizeof(names[0]); ++c) {
+        uint64_t ops = 0;
+        double const start = now();
+        double elapsed;
+        do {
+            for (unsigned i = 0; i != 1024; ++i) {
+                in[0] = i;
+                switch (c) {
+                case 0: SHA3_512_40(out, in); break;
+                case 1: SHA3_512_64(out, in); break;
+                default: SHA3_256_96(out, in); break;
+                }
+                in[1] ^= out[0];
+            }
+            ops += 1024;
+            elapsed = now() - start;
+        } while (elapsed < config->seconds / 4);
+        result_begin(names[c], "none");
+        printf(", \"ns_per_op\": %.1f}", elapsed * 1e9 / ops);
+    }
+}
+
+typedef struct hash_job {
+    node const *full_nodes;
+    ethash_params const *params;
+    uint64_t first_nonce;
+    int batch;
+    double seconds;
+    uint64_t hashes;
+} hash_job;
+
+static void *hash_worker(void *arg) {
+    hash_job *job = (hash_job *) arg;
+    uint8_t header[32] = {0};
+    uint64_t nonces[64];
+    ethash_return_value values[64];
+    uint64_t nonce = job->first_nonce;
+    double const start = now();
+    do {
+        if (job->batch) {
+            for (unsigned k = 0; k != 64; ++k) {
+                nonces[k] = nonce++;
+            }
+            ethash_hash_batch(values, job->full_nodes, job->params, header, nonces, 64);
+        } else {
+            for (unsigned k = 0; k != 64; ++k) {
+                ethash_hash(&values[k], job->full_nodes, job->params, header, nonce++);
+            }
+        }
+        job->hashes += 64;
+    } while (now() - start < job->seconds);
+    return NULL;
+}
+
+// Hashes per second of threads workers on full_nodes.
+static double hash_rate(bench_config const *config, node const *full_nodes, ethash_params const *params,
+        unsigned threads, int batch) {
+    hash_job jobs[threads];
+    pthread_t ids[threads];
+    for (unsigned i = 0; i != threads; ++i) {
+        jobs[i].full_nodes = full_nodes;
+        jobs[i].params = params;
+        jobs[i].first_nonce = (uint64_t) i << 40;
+        jobs[i].batch = batch;
+        jobs[i].seconds = config->seconds;
+        jobs[i].hashes = 0;
+    }
+    double const start = now();
+    for (unsigned i = 1; i < threads; ++i) {
+        if (pthread_create(&ids[i], NULL, hash_worker, &jobs[i]) != 0) {
+            hash_worker(&jobs[i]);
+            ids[i] = pthread_self();
+        }
+    }
+    hash_worker(&jobs[0]);
+    uint64_t hashes = jobs[0].hashes;
+    for (unsigned i = 1; i < threads; ++i) {
+        if (!pthread_equal(ids[i], pthread_self())) {
+            pthread_join(ids[i], NULL);
+        }
+        hashes += jobs[i].hashes;
+    }
+    return hashes / (now() - start);
+}
+
+static void bench_hash(bench_config const *config, char const *dataset, node const *full_nodes, ethash_params const *params) {
+    unsigned const thread_counts[2] = {1, config->threads};
+    for (int batch = 0; batch != 2; ++batch) {
+        for (unsigned t = 0; t != 2; ++t) {
+            unsigned const threads = thread_counts[t];
+            if (t == 1 && threads == 1) {
+                continue;
+            }
+            double const rate = hash_rate(config, full_nodes, params, threads, batch);
+            result_begin(batch ? "ethash_hash_batch" : "ethash_hash", dataset);
+            printf(", \"threads\": %u, \"hashes_per_s\": %.0f, \"dag_gb_per_s\": %.2f}",
+                    threads, rate, rate * ETHASH_DAG_BYTES_PER_HASH / 1e9);
+        }
+    }
+}
+
+// ethash_hash_batch on every thread from a copy of the DAG on 4 KB pages, as
+// a file mapping gives it, next to the same on the huge pages of dag. Most
+// page reads are TLB misses on 4 KB pages once the DAG is far larger than
+// the TLB reach, so the gap grows with the DAG.
+static void bench_pages(bench_config const *config, char const *dataset, ethash_dag_mem const *dag, ethash_params const *params) {
+    void *small = mmap(NULL, params->full_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (small == MAP_FAILED) {
+        return;
+    }
+    madvise(small, params->full_size, MADV_NOHUGEPAGE);
+    memcpy(small, dag->ptr, params->full_size);
+    for (int huge = 0; huge != 2; ++huge) {
+        double const rate = hash_rate(config, (node const *) (huge ? dag->ptr : small), params, config->threads, 1);
+        result_begin("dag_pages", dataset);
+        printf(", \"pages\": \"%s\", \"threads\": %u, \"hashes_per_s\": %.0f}",
+                ethash_page_kind_name(huge ? dag->pages : ETHASH_PAGES_NORMAL), config->threads, rate);
+    }
+    munmap(small, params->full_size);
+}
+
+static int compare_double(void const *a, void const *b) {
+    double const x = *(double const *) a, y = *(double const *) b;
+    return (x > y) - (x < y);
+}
+
+// Latency of one ethash_light_compute, as a pool or node verifying a share
+// without the DAG sees it.
+static void bench_light(bench_config const *config, char const *dataset, ethash_cache const *cache, ethash_params const *params) {
+    double *latency = malloc(config->samples * sizeof(double));
+    uint8_t header[32] = {1};
+    if (!latency) {
+        return;
+    }
+    for (int use_lru = 0; use_lru != 2; ++use_lru) {
+        ethash_item_lru *lru = use_lru ? ethash_item_lru_new(1 << 16) : NULL;
+        for (unsigned i = 0; i != config->samples; ++i) {
+            ethash_return_value value;
+            double const start = now();
+            ethash_light_compute(&value, cache, lru, params, header, (uint64_t) i * 0x9e3779b97f4a7c15ULL);
+            latency[i] = now() - start;
+        }
+        qsort(latency, config->samples, sizeof(double), compare_double);
+        unsigned const n = config->samples;
+        result_begin("light_verify", dataset);
+        printf(", \"lru\": %s, \"samples\": %u, \"p50_us\": %.1f, \"p90_us\": %.1f, \"p99_us\": %.1f, \"max_us\": %.1f}",
+                use_lru ? "true" : "false", n,
+                latency[n / 2] * 1e6, latency[n * 9 / 10] * 1e6, latency[n * 99 / 100] * 1e6, latency[n - 1] * 1e6);
+        if (lru) {
+            ethash_item_lru_delete(lru);
+        }
+    }
+    free(latency);
+}
+
+// Hash rate and hit rates of the partial DAG at a range of memory budgets,
+// from the light path (nothing resident) to the whole DAG.
+static void bench_partial(bench_config const *config, char const *dataset, ethash_cache const *cache, ethash_params const *params) {
+    static double const fractions[] = {0, 0.25, 0.5, 0.75, 1};
+    uint8_t header[32] = {2};
+    for (unsigned f = 0; f != sizeof(fractions) / sizeof(fractions[0]); ++f) {
+        ethash_partial_dag *dag = ethash_partial_dag_new(params, cache, fractions[f], 1 << 16);
+        if (!dag) {
+            continue;
+        }
+        uint64_t nonce = 0;
+        double const start = now();
+        do {
+            for (unsigned k = 0; k != 16; ++k) {
+                ethash_return_value value;
+                ethash_partial_hash(&value, dag, header, nonce++);
+            }
+        } while (now() - start < config->seconds);
+        double const elapsed = now() - start;
+
+        ethash_partial_stats stats;
+        ethash_partial_dag_stats(dag, &stats);
+        uint64_t const lookups = stats.lru_hits + stats.lru_misses;
+        result_begin("partial_dag", dataset);
+        printf(", \"resident_fraction\": %.2f, \"resident_bytes\": %zu, \"hashes_per_s\": %.0f"
+                ", \"resident_hit_rate\": %.3f, \"lru_hit_rate\": %.3f}",
+                fractions[f], stats.resident_bytes, stats.hashes / elapsed,
+                1 - (double) stats.derived_pages / stats.page_reads,
+                lookups ? (double) stats.lru_hits / lookups : 0.0);
+        ethash_partial_dag_delete(dag);
+    }
+}
+
+// Generates cache and DAG for params, timing both, then runs the hash and
+// light cases on them.
+static int bench_dataset(bench_config const *config, char const *dataset, ethash_params const *params, uint8_t const seed[32]) {
+    ethash_cache cache;
+    cache.mem = malloc(params->cache_size);
+    ethash_dag_mem dag;
+    if (!cache.mem || ethash_dag_alloc(&dag, params->full_size, ETHASH_NUMA_INTERLEAVE) != 0) {
+        free(cache.mem);
+        fprintf(stderr, "bench: unable to allocate %zu bytes of DAG\n", params->full_size);
+        return -1;
+    }
+
+    double start = now();
+    ethash_mkcache(&cache, params, seed);
+    result_begin("mkcache", dataset);
+    printf(", \"cache_bytes\": %zu, \"seconds\": %.3f}", params->cache_size, now() - start);
+
+    start = now();
+    ethash_compute_full_data(dag.ptr, params, &cache);
+    double const elapsed = now() - start;
+    result_begin("dag_generation", dataset);
+    printf(", \"full_bytes\": %zu, \"pages\": \"%s\", \"seconds\": %.3f, \"mb_per_s\": %.1f}",
+            params->full_size, ethash_page_kind_name(dag.pages), elapsed, params->full_size / elapsed / 1e6);
+
+    bench_hash(config, dataset, (node const *) dag.ptr, params);
+    bench_pages(config, dataset, &dag, params);
+    bench_light(config, dataset, &cache, params);
+    bench_partial(config, dataset, &cache, params);
+
+    ethash_dag_free(&dag);
+    free(cache.mem);
+    return 0;
+}
+
+static int self_test(void) {
+    char error[256];
+    double const start = now();
+    if (ethash_self_test(1, error, sizeof(error)) != 0 || ethash_verify_self_test(error, sizeof(error)) != 0) {
+        printf("self test failed: %s\n", error);
+        return 1;
+    }
+    printf("self test passed in %.2f s\n", now() - start);
+    return 0;
+}
+
+static void usage(char const *name) {
+    fprintf(stderr,
+            "Usage: %s [-d dag_mb] [-b block_number] [-t threads] [-s seconds] [-n samples]\n"
+            "       %s --selftest\n"
+            "  -d  size of the synthetic DAG in MB (default 16, cache is 1/64 of it)\n"
+            "  -b  also run on the full DAG of this block's epoch (takes minutes)\n"
+            "  -t  threads for the parallel cases (default: online CPUs)\n"
+            "  -s  seconds per throughput case (default 1)\n"
+            "  -n  light verifications timed for percentiles (default 200)\n"
+            "  --selftest  run the known-answer and cross-path checks, no timing\n",
+            name, name);
+}
+
+int main(int argc, char **argv) {
+    bench_config config;
+    long const online = sysconf(_SC_NPROCESSORS_ONLN);
+    config.seconds = 1;
+    config.threads = online > 0 ? (unsigned) online : 1;
+    config.samples = 200;
+    unsigned long dag_mb = 16;
+    long block_number = -1;
+
+    static const struct option long_options[] = {
+        {"selftest", no_argument, NULL, 'S'},
+        {NULL, 0, NULL, 0}
+    };
+    int opt;
+    while ((opt = getopt_long(argc, argv, "d:b:t:s:n:h", long_options, NULL)) != -1) {
+        switch (opt) {
+        case 'S': return self_test();
+        case 'd': dag_mb = strtoul(optarg, NULL, 10); break;
+        case 'b': block_number = strtol(optarg, NULL, 10); break;
+        case 't': config.threads = (unsigned) strtoul(optarg, NULL, 10); break;
+        case 's': config.seconds = strtod(optarg, NULL); break;
+        case 'n': config.samples = (unsigned) strtoul(optarg, NULL, 10); break;
+        default: usage(argv[0]); return opt == 'h' ? 0 : 1;
+        }
+    }
+    if (!dag_mb || !config.threads || !config.samples || config.seconds <= 0) {
+        usage(argv[0]);
+        return 1;
+    }
+
+    printf("{\n  \"cpu_threads\": %ld, \"bench_threads\": %u, \"simd_lanes\": %u, \"seconds_per_case\": %.2f,\n  \"results\": [",
+            online, config.threads, ethash_hash_batch_lanes(), config.seconds);
+
+    bench_keccak(&config);
+
+    // synthetic: any multiple of a page for the DAG and of a node for the
+    // cache is a valid configuration for every function here
+    ethash_params synthetic;
+    synthetic.full_size = (size_t) dag_mb << 20;
+    synthetic.cache_size = (synthetic.full_size / 64) & ~(size_t) 63;
+    uint8_t seed[32] = {0};
+    int rc = bench_dataset(&config, "synthetic", &synthetic, seed);
+
+    if (rc == 0 && block_number >= 0) {
+        ethash_params const params = ethash_get_params((uint32_t) block_number);
+        ethash_get_seedhash(seed, (uint32_t) block_number);
+        char dataset[32];
+        snprintf(dataset, sizeof(dataset), "epoch_%lu", (unsigned long) block_number / ETHASH_EPOCH_LENGTH);
+        rc = bench_dataset(&config, dataset, &params, seed);
+    }
+
+    printf("\n  ]\n}\n");
+    return rc == 0 ? 0 : 1;
+}
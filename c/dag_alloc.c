@@ -0,0 +1,313 @@
+/*
+  This file is part of ethash.
+
+  ethash is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  ethash is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with ethash.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file dag_alloc.c
+* @date 2026
+*/
+
+#define _GNU_SOURCE
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "dag_alloc.h"
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#ifndef MAP_HUGE_SHIFT
+#define MAP_HUGE_SHIFT 26
+#endif
+#define MAP_HUGE_2MB_FLAG (21 << MAP_HUGE_SHIFT)
+#define MAP_HUGE_1GB_FLAG (30 << MAP_HUGE_SHIFT)
+#ifndef MADV_POPULATE_WRITE
+#define MADV_POPULATE_WRITE 23
+#endif
+
+// from <numaif.h>, kept local so libnuma is not required
+#define MPOL_BIND 2
+#define MPOL_INTERLEAVE 3
+#define NUMA_MAX_NODES 1024
+
+#define SIZE_2MB ((size_t) 1 << 21)
+#define SIZE_1GB ((size_t) 1 << 30)
+#endif
+
+static size_t round_up(size_t size, size_t align) {
+    return (size + align - 1) & ~(align - 1);
+}
+
+size_t ethash_dag_shard_bytes(size_t full_size, unsigned shards, size_t align) {
+    if (shards < 2) {
+        return round_up(full_size, align);
+    }
+    return round_up((full_size + shards - 1) / shards, align);
+}
+
+const char *ethash_page_kind_name(ethash_page_kind pages) {
+    switch (pages) {
+    case ETHASH_PAGES_THP: return "thp";
+    case ETHASH_PAGES_2MB: return "2MB";
+    case ETHASH_PAGES_1GB: return "1GB";
+    default: return "4KB";
+    }
+}
+
+#ifdef __linux__
+
+// Parses a sysfs list such as "0-3,8,10-11" into a callback per entry.
+static int parse_list(char const *path, void (*each)(unsigned, void *), void *ctx) {
+    FILE *f = fopen(path, "r");
+    if (!f) {
+        return -1;
+    }
+    char buf[4096];
+    size_t len = fread(buf, 1, sizeof(buf) - 1, f);
+    fclose(f);
+    buf[len] = 0;
+
+    char *p = buf;
+    while (*p && *p != '\n') {
+        char *end;
+        unsigned long first = strtoul(p, &end, 10);
+        unsigned long last = first;
+        if (end == p) {
+            return -1;
+        }
+        if (*end == '-') {
+            p = end + 1;
+            last = strtoul(p, &end, 10);
+        }
+        for (unsigned long i = first; i <= last; ++i) {
+            each((unsigned) i, ctx);
+        }
+        p = *end == ',' ? end + 1 : end;
+    }
+    return 0;
+}
+
+static void count_node(unsigned node, void *ctx) {
+    unsigned *max_node = (unsigned *) ctx;
+    if (node + 1 > *max_node) {
+        *max_node = node + 1;
+    }
+}
+
+unsigned ethash_numa_nodes(void) {
+    unsigned nodes = 0;
+    if (parse_list("/sys/devices/system/node/online", count_node, &nodes) != 0 || nodes == 0) {
+        return 1;
+    }
+    return nodes;
+}
+
+static void add_cpu(unsigned cpu, void *ctx) {
+    if (cpu < CPU_SETSIZE) {
+        CPU_SET(cpu, (cpu_set_t *) ctx);
+    }
+}
+
+int ethash_numa_pin_thread(int numa_node) {
+    if (numa_node < 0) {
+        return -1;
+    }
+    char path[64];
+    snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", numa_node);
+    cpu_set_t cpus;
+    CPU_ZERO(&cpus);
+    if (parse_list(path, add_cpu, &cpus) != 0 || CPU_COUNT(&cpus) == 0) {
+        return -1;
+    }
+    return pthread_setaffinity_np(pthread_self(), sizeof(cpus), &cpus) == 0 ? 0 : -1;
+}
+
+static int numa_place(void *ptr, size_t len, int numa_node, size_t align);
+
+// Binds shard k of the range-sharded layout to node k, so threads pinned to a
+// node find the pages of its shard local.
+static int numa_place_sharded(void *ptr, size_t len, size_t align) {
+    unsigned const nodes = ethash_numa_nodes();
+    size_t const shard = ethash_dag_shard_bytes(len, nodes, align);
+    for (unsigned k = 0; k != nodes && k * shard < len; ++k) {
+        size_t const rest = len - k * shard;
+        if (numa_place((uint8_t *) ptr + k * shard, rest < shard ? rest : shard, (int) k, align) != (int) k) {
+            return ETHASH_NUMA_ANY;
+        }
+    }
+    return ETHASH_NUMA_SHARDED;
+}
+
+// Applies the placement policy before first touch; failure leaves the default
+// policy in place, which is still correct, just not local. align is the page
+// size backing the range.
+static int numa_place(void *ptr, size_t len, int numa_node, size_t align) {
+    unsigned const nodes = ethash_numa_nodes();
+    if (numa_node == ETHASH_NUMA_ANY || nodes < 2) {
+        return ETHASH_NUMA_ANY;
+    }
+    if (numa_node == ETHASH_NUMA_SHARDED) {
+        return numa_place_sharded(ptr, len, align);
+    }
+    unsigned long mask[NUMA_MAX_NODES / (8 * sizeof(unsigned long))];
+    memset(mask, 0, sizeof(mask));
+    int mode;
+    if (numa_node == ETHASH_NUMA_INTERLEAVE) {
+        for (unsigned n = 0; n < nodes && n < NUMA_MAX_NODES; ++n) {
+            mask[n / (8 * sizeof(unsigned long))] |= 1UL << (n % (8 * sizeof(unsigned long)));
+        }
+        mode = MPOL_INTERLEAVE;
+    } else {
+        if ((unsigned) numa_node >= nodes || numa_node >= NUMA_MAX_NODES) {
+            return ETHASH_NUMA_ANY;
+        }
+        mask[numa_node / (8 * sizeof(unsigned long))] |= 1UL << (numa_node % (8 * sizeof(unsigned long)));
+        mode = MPOL_BIND;
+    }
+    if (syscall(SYS_mbind, ptr, len, mode, mask, (unsigned long) NUMA_MAX_NODES + 1, 0) != 0) {
+        return ETHASH_NUMA_ANY;
+    }
+    return numa_node;
+}
+
+static void *map_anonymous(size_t len, int extra_flags) {
+    void *ptr = mmap(NULL, len, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | extra_flags, -1, 0);
+    return ptr == MAP_FAILED ? NULL : ptr;
+}
+
+// 2 MB aligned anonymous mapping so THP can back all of it
+static void *map_thp(size_t len) {
+    uint8_t *raw = (uint8_t *) map_anonymous(len + SIZE_2MB, 0);
+    if (!raw) {
+        return NULL;
+    }
+    uint8_t *aligned = (uint8_t *) round_up((uintptr_t) raw, SIZE_2MB);
+    if (aligned != raw) {
+        munmap(raw, aligned - raw);
+    }
+    size_t const tail = (raw + len + SIZE_2MB) - (aligned + len);
+    if (tail) {
+        munmap(aligned + len, tail);
+    }
+    madvise(aligned, len, MADV_HUGEPAGE);
+    return aligned;
+}
+
+// A MAP_HUGETLB mapping of len bytes of page_size pages, placed. The huge
+// page reservation made by mmap is pool-wide, not per node, so once a policy
+// binds the range a node short of huge pages would only show as SIGBUS on
+// first touch: the range is faulted in here instead, and dropped if that
+// fails, so the caller falls back to smaller pages.
+static int map_hugetlb(ethash_dag_mem *mem, size_t len, int page_flag, size_t page_size, int numa_node) {
+    void *ptr = map_anonymous(len, MAP_HUGETLB | page_flag);
+    if (!ptr) {
+        return -1;
+    }
+    int const placed = numa_place(ptr, len, numa_node, page_size);
+    if (numa_node != ETHASH_NUMA_ANY && ethash_numa_nodes() > 1 && madvise(ptr, len, MADV_POPULATE_WRITE) != 0) {
+        munmap(ptr, len);
+        return -1;
+    }
+    mem->ptr = ptr;
+    mem->mapped = len;
+    mem->pages = page_size == SIZE_1GB ? ETHASH_PAGES_1GB : ETHASH_PAGES_2MB;
+    mem->numa_node = placed;
+    return 0;
+}
+
+int ethash_dag_alloc(ethash_dag_mem *mem, size_t size, int numa_node) {
+    memset(mem, 0, sizeof(*mem));
+    mem->size = size;
+    mem->numa_node = ETHASH_NUMA_ANY;
+
+    if (size >= SIZE_1GB && map_hugetlb(mem, round_up(size, SIZE_1GB), MAP_HUGE_1GB_FLAG, SIZE_1GB, numa_node) == 0) {
+        return 0;
+    }
+    size_t const len = round_up(size, SIZE_2MB);
+    if (map_hugetlb(mem, len, MAP_HUGE_2MB_FLAG, SIZE_2MB, numa_node) == 0) {
+        return 0;
+    }
+    // THP falls back to 4 KB pages where a node has no huge page to spare
+    if ((mem->ptr = map_thp(len))) {
+        mem->mapped = len;
+        mem->pages = ETHASH_PAGES_THP;
+        mem->numa_node = numa_place(mem->ptr, len, numa_node, SIZE_2MB);
+        return 0;
+    }
+    size_t const small_len = round_up(size, 4096);
+    if (posix_memalign(&mem->ptr, 4096, small_len) != 0) {
+        mem->ptr = NULL;
+        return -1;
+    }
+    mem->pages = ETHASH_PAGES_NORMAL;
+    mem->numa_node = numa_place(mem->ptr, small_len, numa_node, 4096);
+    return 0;
+}
+
+void ethash_dag_free(ethash_dag_mem *mem) {
+    if (!mem->ptr) {
+        return;
+    }
+    if (mem->mapped) {
+        munmap(mem->ptr, mem->mapped);
+    } else {
+        free(mem->ptr);
+    }
+    mem->ptr = NULL;
+    mem->mapped = 0;
+}
+
+#else
+
+unsigned ethash_numa_nodes(void) {
+    return 1;
+}
+
+int ethash_numa_pin_thread(int numa_node) {
+    (void) numa_node;
+    return -1;
+}
+
+int ethash_dag_alloc(ethash_dag_mem *mem, size_t size, int numa_node) {
+    (void) numa_node;
+    memset(mem, 0, sizeof(*mem));
+    mem->size = size;
+    mem->numa_node = ETHASH_NUMA_ANY;
+    mem->pages = ETHASH_PAGES_NORMAL;
+    if (posix_memalign(&mem->ptr, 4096, round_up(size, 4096)) != 0) {
+        mem->ptr = NULL;
+        return -1;
+    }
+    return 0;
+}
+
+void ethash_dag_free(ethash_dag_mem *mem) {
+    free(mem->ptr);
+    mem->ptr = NULL;
+}
+
+#endif
+
+int ethash_dag_replicate(ethash_dag_mem *dst, ethash_dag_mem const *src, int numa_node) {
+    if (ethash_dag_alloc(dst, src->size, numa_node) != 0) {
+        return -1;
+    }
+    memcpy(dst->ptr, src->ptr, src->size);
+    return 0;
+}
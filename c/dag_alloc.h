@@ -0,0 +1,77 @@
+/*
+  This file is part of ethash.
+
+  ethash is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  ethash is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with ethash.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file dag_alloc.h
+* @date 2026
+*
+* DAG memory on huge pages, optionally placed on NUMA nodes. Every DAG access
+* is a random 128-byte read, so on 4 KB pages nearly each one is a TLB miss.
+*/
+#pragma once
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum ethash_page_kind {
+    ETHASH_PAGES_NORMAL = 0,        // posix_memalign, 4 KB pages
+    ETHASH_PAGES_THP,               // anonymous mapping with MADV_HUGEPAGE
+    ETHASH_PAGES_2MB,               // MAP_HUGETLB, 2 MB pages
+    ETHASH_PAGES_1GB                // MAP_HUGETLB, 1 GB pages
+} ethash_page_kind;
+
+// numa_node arguments besides a node number
+#define ETHASH_NUMA_ANY -1          // leave placement to the kernel
+#define ETHASH_NUMA_INTERLEAVE -2   // spread pages round-robin over all nodes
+#define ETHASH_NUMA_SHARDED -3      // one ethash_dag_shard_bytes range per node, in node order
+
+typedef struct ethash_dag_mem {
+    void *ptr;
+    size_t size;                    // requested bytes
+    size_t mapped;                  // mapping length, 0 when from posix_memalign
+    ethash_page_kind pages;
+    int numa_node;                  // node or policy actually applied
+} ethash_dag_mem;
+
+// Tries 1 GB pages (for sizes of at least 1 GB), then 2 MB pages, then
+// transparent huge pages, then plain 4 KB pages. Huge pages placed on NUMA
+// nodes are faulted in up front, so a node short of them means the next
+// kind, not SIGBUS later. Returns 0 on success.
+int ethash_dag_alloc(ethash_dag_mem *mem, size_t size, int numa_node);
+void ethash_dag_free(ethash_dag_mem *mem);
+
+// Size of each of shards contiguous ranges the DAG is split into, rounded up
+// to align bytes; the last shard holds what is left. The layout krnl_ethash
+// expects for banked DAG ports (with align 4096), and the one
+// ETHASH_NUMA_SHARDED binds to nodes.
+size_t ethash_dag_shard_bytes(size_t full_size, unsigned shards, size_t align);
+
+// Allocates dst on numa_node and copies src into it, for per-node replicas.
+int ethash_dag_replicate(ethash_dag_mem *dst, ethash_dag_mem const *src, int numa_node);
+
+const char *ethash_page_kind_name(ethash_page_kind pages);
+
+// Number of NUMA nodes (1 on non-NUMA or non-Linux hosts).
+unsigned ethash_numa_nodes(void);
+
+// Pins the calling thread to the CPUs of numa_node. Returns 0 on success.
+int ethash_numa_pin_thread(int numa_node);
+
+#ifdef __cplusplus
+}
+#endif
@@ -25,33 +25,19 @@
 #include <stddef.h>
 #include <stdint.h>
 #include <stdbool.h>
+#include <stdlib.h>
 #include <string.h>
 #include <stddef.h>
+#include <pthread.h>
+#include <unistd.h>
+#include "ethash.h"
+#include "ethash_core.h"
+#include "data_sizes.h"
 
 /*
  * BEGIN code from all headers
  */
 
- #define MIX_BYTES 128
- #define HASH_BYTES 64
- #define DATASET_PARENTS 256
- #define CACHE_ROUNDS 3
- #define ACCESSES 64
-
- /*
-  * BEGIN from fnv.h
-  */
-
- #define FNV_PRIME 0x01000193
-
- static inline uint32_t fnv_hash(const uint32_t x, const uint32_t y) {
- 	return x*FNV_PRIME ^ y;
- }
-
- /*
-  * END from fnv.h
-  */
-
  /*
   * BEGIN from sha3.h
   */
@@ -78,231 +64,788 @@
    * BEGIN from internal.h
    */
 
-   // compile time settings
-   #define NODE_WORDS (64/4)
-   #define MIX_WORDS (MIX_BYTES/4)
-   #define MIX_NODES (MIX_WORDS / NODE_WORDS)
-   #include <stdint.h>
-
-   typedef union node {
+   union node {
        uint8_t bytes[NODE_WORDS * 4];
        uint32_t words[NODE_WORDS];
        uint64_t double_words[NODE_WORDS / 2];
-   } node;
+   };
 
    /*
     * END from internal.h
     */
 
- typedef struct ethash_params {
-     size_t full_size;               // Size of full data set (in bytes, multiple of mix size (128)).
-     size_t cache_size;              // Size of compute cache (in bytes, multiple of node size (64)).
- } ethash_params;
-
- typedef struct ethash_return_value {
-     uint8_t result[32];
-     uint8_t mix_hash[32];
- } ethash_return_value;
-
  /*
   * END code from all headers
   */
 
 /*
- * BEGIN from sha3.c
+ * Keccak-256 and Keccak-512 of any length, with the original 0x01 padding
+ * Ethereum uses, on the keccakf1600 of ethash_core.h. Lanes are read and
+ * written little-endian byte by byte, so any host order works.
  */
 
- /******** The Keccak-f[1600] permutation ********/
-
- /*** Constants. ***/
- static const uint8_t rho[24] = \
-   { 1,  3,   6, 10, 15, 21,
-         28, 36, 45, 55,  2, 14,
-         27, 41, 56,  8, 25, 43,
-         62, 18, 39, 61, 20, 44};
- static const uint8_t pi[24] = \
-   {10,  7, 11, 17, 18, 3,
-         5, 16,  8, 21, 24, 4,
-         15, 23, 19, 13, 12, 2,
-         20, 14, 22,  9, 6,  1};
- static const uint64_t RC[24] = \
-   {1ULL, 0x8082ULL, 0x800000000000808aULL, 0x8000000080008000ULL,
-         0x808bULL, 0x80000001ULL, 0x8000000080008081ULL, 0x8000000000008009ULL,
-         0x8aULL, 0x88ULL, 0x80008009ULL, 0x8000000aULL,
-         0x8000808bULL, 0x800000000000008bULL, 0x8000000000008089ULL, 0x8000000000008003ULL,
-         0x8000000000008002ULL, 0x8000000000000080ULL, 0x800aULL, 0x800000008000000aULL,
-         0x8000000080008081ULL, 0x8000000000008080ULL, 0x80000001ULL, 0x8000000080008008ULL};
-
- /*** Helper macros to unroll the permutation. ***/
- #define rol(x, s) (((x) << s) | ((x) >> (64 - s)))
- #define REPEAT6(e) e e e e e e
- #define REPEAT24(e) REPEAT6(e e e e)
- #define REPEAT5(e) e e e e e
- #define FOR5(v, s, e) \
-   v = 0;            \
-   REPEAT5(e; v += s;)
-
- /*** Keccak-f[1600] ***/
- static inline void keccakf(void* state) {
-     uint64_t* a = (uint64_t*)state;
-     uint64_t b[5] = {0};
-     uint64_t t = 0;
-     uint8_t x, y;
-
-     for (int i = 0; i < 24; i++) {
-         // Theta
-         FOR5(x, 1,
-                 b[x] = 0;
-                 FOR5(y, 5,
-                         b[x] ^= a[x + y]; ))
-         FOR5(x, 1,
-                 FOR5(y, 5,
-                         a[y + x] ^= b[(x + 4) % 5] ^ rol(b[(x + 1) % 5], 1); ))
-         // Rho and pi
-         t = a[1];
-         x = 0;
-         REPEAT24(b[0] = a[pi[x]];
-                 a[pi[x]] = rol(t, rho[x]);
-                 t = b[0];
-                 x++; )
-         // Chi
-         FOR5(y,
-                 5,
-                 FOR5(x, 1,
-                         b[x] = a[y + x];)
-                 FOR5(x, 1,
-                 a[y + x] = b[x] ^ ((~b[(x + 1) % 5]) & b[(x + 2) % 5]); ))
-         // Iota
-         a[0] ^= RC[i];
-     }
- }
+static inline void keccak_absorb(uint64_t a[25], uint8_t const *in, size_t len) {
+    for (size_t i = 0; i != len; ++i) {
+        a[i / 8] ^= (uint64_t) in[i] << (8 * (i % 8));
+    }
+}
 
- /******** The FIPS202-defined functions. ********/
-
- /*** Some helper macros. ***/
-
- #define _(S) do { S } while (0)
- #define FOR(i, ST, L, S) \
-   _(for (size_t i = 0; i < L; i += ST) { S; })
- #define mkapply_ds(NAME, S)                                          \
-   static inline void NAME(uint8_t* dst,                              \
-                           const uint8_t* src,                        \
-                           size_t len) {                              \
-     FOR(i, 1, len, S);                                               \
-   }
- #define mkapply_sd(NAME, S)                                          \
-   static inline void NAME(const uint8_t* src,                        \
-                           uint8_t* dst,                              \
-                           size_t len) {                              \
-     FOR(i, 1, len, S);                                               \
-   }
-
- mkapply_ds(xorin, dst[i] ^= src[i])  // xorin
- mkapply_sd(setout, dst[i] = src[i])  // setout
-
- #define P keccakf
- #define Plen 200
-
- // Fold P*F over the full blocks of an input.
- #define foldP(I, L, F) \
-   while (L >= rate) {  \
-     F(a, I, rate);     \
-     P(a);              \
-     I += rate;         \
-     L -= rate;         \
-   }
-
- /** The sponge-based hash construction. **/
- static inline int hash(uint8_t* out, size_t outlen,
-         const uint8_t* in, size_t inlen,
-         size_t rate, uint8_t delim) {
-     if ((out == NULL) || ((in == NULL) && inlen != 0) || (rate >= Plen)) {
-         return -1;
-     }
-     uint8_t a[Plen] = {0};
-     // Absorb input.
-     foldP(in, inlen, xorin);
-     // Xor in the DS and pad frame.
-     a[inlen] ^= delim;
-     a[rate - 1] ^= 0x80;
-     // Xor in the last block.
-     xorin(a, in, inlen);
-     // Apply P
-     P(a);
-     // Squeeze output.
-     foldP(out, outlen, setout);
-     setout(a, out, outlen);
-     memset(a, 0, 200);
-     return 0;
- }
+static int keccak(uint8_t *out, size_t outlen, uint8_t const *in, size_t inlen, size_t rate) {
+    if (out == NULL || (in == NULL && inlen != 0)) {
+        return -1;
+    }
+    uint64_t a[25] = {0};
+    for (; inlen >= rate; in += rate, inlen -= rate) {
+        keccak_absorb(a, in, rate);
+        keccakf1600(a);
+    }
+    keccak_absorb(a, in, inlen);
+    a[inlen / 8] ^= (uint64_t) 0x01 << (8 * (inlen % 8));
+    a[(rate - 1) / 8] ^= (uint64_t) 0x80 << (8 * ((rate - 1) % 8));
+    keccakf1600(a);
+    // outlen is at most 64 bytes, within a single squeeze of either rate
+    for (size_t i = 0; i != outlen; ++i) {
+        out[i] = (uint8_t) (a[i / 8] >> (8 * (i % 8)));
+    }
+    return 0;
+}
 
- #define defsha3(bits)                                             \
-   int sha3_##bits(uint8_t* out, size_t outlen,                    \
-                   const uint8_t* in, size_t inlen) {              \
-     if (outlen > (bits/8)) {                                      \
-       return -1;                                                  \
-     }                                                             \
-     return hash(out, outlen, in, inlen, 200 - (bits / 4), 0x01);  \
-   }
+#define defsha3(bits)                                             \
+  int sha3_##bits(uint8_t* out, size_t outlen,                    \
+                  const uint8_t* in, size_t inlen) {              \
+    if (outlen > (bits/8)) {                                      \
+      return -1;                                                  \
+    }                                                             \
+    return keccak(out, outlen, in, inlen, 200 - (bits / 4));      \
+  }
+
+defsha3(256)
+defsha3(512)
+
+void ethash_get_seedhash(uint8_t seedhash[32], const uint32_t block_number) {
+    uint32_t const epochs = block_number / ETHASH_EPOCH_LENGTH;
+    memset(seedhash, 0, 32);
+    for (uint32_t i = 0; i < epochs; ++i) {
+        SHA3_256(seedhash, seedhash, 32);
+    }
+}
 
- /*** FIPS202 SHA3 FOFs ***/
- defsha3(256)
- defsha3(512)
+int32_t ethash_get_seedhash_epoch(const uint8_t seedhash[32], const uint32_t max_epochs) {
+    uint8_t seed[32];
+    memset(seed, 0, 32);
+    for (uint32_t epoch = 0; epoch < max_epochs && epoch <= INT32_MAX; ++epoch) {
+        if (memcmp(seed, seedhash, 32) == 0) {
+            return (int32_t) epoch;
+        }
+        SHA3_256(seed, seed, 32);
+    }
+    return -1;
+}
 
- /*
-  * END from sha3.c
-  */
+static bool is_prime(uint64_t n) {
+    if (n < 2) {
+        return false;
+    }
+    if (n % 2 == 0) {
+        return n == 2;
+    }
+    for (uint64_t d = 3; d * d <= n; d += 2) {
+        if (n % d == 0) {
+            return false;
+        }
+    }
+    return true;
+}
 
-void ethash_hash(
+uint64_t ethash_get_full_size(const uint32_t block_number) {
+    uint32_t const epoch = block_number / ETHASH_EPOCH_LENGTH;
+    if (epoch < SIZE_TABLE_EPOCHS) {
+        return dag_sizes[epoch];
+    }
+    uint64_t size = DATASET_BYTES_INIT + (uint64_t) DATASET_BYTES_GROWTH * epoch - MIX_BYTES;
+    while (!is_prime(size / MIX_BYTES)) {
+        size -= 2 * MIX_BYTES;
+    }
+    return size;
+}
+
+uint64_t ethash_get_cache_size(const uint32_t block_number) {
+    uint32_t const epoch = block_number / ETHASH_EPOCH_LENGTH;
+    if (epoch < SIZE_TABLE_EPOCHS) {
+        return cache_sizes[epoch];
+    }
+    uint64_t size = CACHE_BYTES_INIT + (uint64_t) CACHE_BYTES_GROWTH * epoch - HASH_BYTES;
+    while (!is_prime(size / HASH_BYTES)) {
+        size -= 2 * HASH_BYTES;
+    }
+    return size;
+}
+
+ethash_params ethash_get_params(const uint32_t block_number) {
+    ethash_params params;
+    params.full_size = (size_t) ethash_get_full_size(block_number);
+    params.cache_size = (size_t) ethash_get_cache_size(block_number);
+    return params;
+}
+
+void ethash_mkcache(ethash_cache *cache, ethash_params const *params, const uint8_t seed[32]) {
+    assert((params->cache_size % sizeof(node)) == 0);
+    node *const nodes = (node *) cache->mem;
+    uint32_t const num_nodes = (uint32_t) (params->cache_size / sizeof(node));
+
+    // sequential fill
+    SHA3_512(nodes[0].bytes, seed, 32);
+    for (unsigned i = 1; i != num_nodes; ++i) {
+        SHA3_512_64(nodes[i].double_words, nodes[i - 1].double_words);
+    }
+
+    // RandMemoHash rounds
+    for (unsigned j = 0; j != CACHE_ROUNDS; j++) {
+        for (unsigned i = 0; i != num_nodes; i++) {
+            uint32_t const idx = nodes[i].words[0] % num_nodes;
+            node data = nodes[(num_nodes - 1 + i) % num_nodes];
+            for (unsigned w = 0; w != NODE_WORDS; ++w) {
+                data.words[w] ^= nodes[idx].words[w];
+            }
+            SHA3_512_64(nodes[i].double_words, data.double_words);
+        }
+    }
+}
+
+static void ethash_calculate_dag_item(
+        node *const ret,
+        const uint32_t node_index,
+        ethash_params const *params,
+        ethash_cache const *cache) {
+
+    uint32_t const num_parent_nodes = (uint32_t) (params->cache_size / sizeof(node));
+    node const *cache_nodes = (node const *) cache->mem;
+
+    memcpy(ret, &cache_nodes[node_index % num_parent_nodes], sizeof(node));
+    ret->words[0] ^= node_index;
+    SHA3_512_64(ret->double_words, ret->double_words);
+
+    for (unsigned i = 0; i != DATASET_PARENTS; ++i) {
+        uint32_t const parent_index = ((node_index ^ i) * FNV_PRIME ^ ret->words[i % NODE_WORDS]) % num_parent_nodes;
+        node const *parent = &cache_nodes[parent_index];
+
+        for (unsigned w = 0; w != NODE_WORDS; ++w) {
+            ret->words[w] = fnv_hash(ret->words[w], parent->words[w]);
+        }
+    }
+    SHA3_512_64(ret->double_words, ret->double_words);
+}
+
+typedef struct full_data_job {
+    node *nodes;
+    ethash_params const *params;
+    ethash_cache const *cache;
+    uint32_t begin;
+    uint32_t end;
+} full_data_job;
+
+static void *ethash_compute_full_data_worker(void *arg) {
+    full_data_job const *job = (full_data_job const *) arg;
+    for (uint32_t n = job->begin; n != job->end; ++n) {
+        ethash_calculate_dag_item(&job->nodes[n], n, job->params, job->cache);
+    }
+    return NULL;
+}
+
+// items [begin, end) into mem[begin, end), on all online cores
+static void ethash_compute_items(node *mem, uint32_t begin, uint32_t end, ethash_params const *params, ethash_cache const *cache) {
+    uint32_t const num_nodes = end - begin;
+    long online = sysconf(_SC_NPROCESSORS_ONLN);
+    unsigned num_threads = online > 0 ? (unsigned) online : 1;
+    if (num_threads > num_nodes) {
+        num_threads = 1;
+    }
+
+    full_data_job jobs[num_threads];
+    pthread_t threads[num_threads];
+    uint32_t const per_thread = num_nodes / num_threads;
+    for (unsigned t = 0; t != num_threads; ++t) {
+        jobs[t].nodes = mem;
+        jobs[t].params = params;
+        jobs[t].cache = cache;
+        jobs[t].begin = begin + t * per_thread;
+        jobs[t].end = (t + 1 == num_threads) ? end : begin + (t + 1) * per_thread;
+    }
+
+    // thread 0 is the caller; fall back to doing the work inline if a spawn fails
+    bool spawned[num_threads];
+    for (unsigned t = 1; t < num_threads; ++t) {
+        spawned[t] = pthread_create(&threads[t], NULL, ethash_compute_full_data_worker, &jobs[t]) == 0;
+    }
+    ethash_compute_full_data_worker(&jobs[0]);
+    for (unsigned t = 1; t < num_threads; ++t) {
+        if (spawned[t]) {
+            pthread_join(threads[t], NULL);
+        } else {
+            ethash_compute_full_data_worker(&jobs[t]);
+        }
+    }
+}
+
+void ethash_compute_full_data(void *mem, ethash_params const *params, ethash_cache const *cache) {
+    assert((params->full_size % (sizeof(uint32_t) * MIX_WORDS)) == 0);
+    assert((params->full_size % sizeof(node)) == 0);
+    ethash_compute_items((node *) mem, 0, (uint32_t) (params->full_size / sizeof(node)), params, cache);
+}
+
+void ethash_compute_full_data_range(void *mem, ethash_params const *params, ethash_cache const *cache, size_t begin, size_t end) {
+    assert(begin % sizeof(node) == 0 && end % sizeof(node) == 0);
+    assert(begin <= end && end <= params->full_size);
+    ethash_compute_items((node *) mem, (uint32_t) (begin / sizeof(node)), (uint32_t) (end / sizeof(node)), params, cache);
+}
+
+/*
+ * Recently derived dataset items for the light path. Hash table keyed by item
+ * index, entries threaded on a doubly linked recency list; LRU_NIL ends both.
+ */
+
+#define LRU_NIL UINT32_MAX
+
+typedef struct lru_entry {
+    node item;
+    uint32_t index;
+    uint32_t prev;
+    uint32_t next;
+    uint32_t chain;
+} lru_entry;
+
+struct ethash_item_lru {
+    pthread_mutex_t lock;
+    void const *owner;              // cache->mem the entries were derived from
+    uint32_t capacity;
+    uint32_t size;
+    uint32_t bucket_mask;
+    uint32_t head;                  // most recently used
+    uint32_t tail;                  // least recently used
+    uint64_t hits;
+    uint64_t misses;
+    uint32_t *buckets;
+    lru_entry *entries;
+};
+
+ethash_item_lru *ethash_item_lru_new(unsigned capacity) {
+    // Twice as many buckets as entries, a power of two that must fit the
+    // uint32_t mask, and entry indexes that must stay below LRU_NIL.
+    size_t const max_capacity = SIZE_MAX / 2 / sizeof(lru_entry);
+    if (capacity == 0 || capacity > (UINT32_MAX >> 2) || capacity > max_capacity) {
+        return NULL;
+    }
+    ethash_item_lru *lru = (ethash_item_lru *) calloc(1, sizeof(ethash_item_lru));
+    if (!lru) {
+        return NULL;
+    }
+    uint32_t num_buckets = 1;
+    while (num_buckets < capacity * 2) {
+        num_buckets <<= 1;
+    }
+    lru->capacity = capacity;
+    lru->bucket_mask = num_buckets - 1;
+    lru->buckets = (uint32_t *) malloc(num_buckets * sizeof(uint32_t));
+    lru->entries = (lru_entry *) malloc(capacity * sizeof(lru_entry));
+    if (!lru->buckets || !lru->entries || pthread_mutex_init(&lru->lock, NULL) != 0) {
+        free(lru->buckets);
+        free(lru->entries);
+        free(lru);
+        return NULL;
+    }
+    ethash_item_lru_clear(lru);
+    return lru;
+}
+
+void ethash_item_lru_delete(ethash_item_lru *lru) {
+    if (!lru) {
+        return;
+    }
+    pthread_mutex_destroy(&lru->lock);
+    free(lru->buckets);
+    free(lru->entries);
+    free(lru);
+}
+
+static void lru_reset(ethash_item_lru *lru) {
+    memset(lru->buckets, 0xff, (lru->bucket_mask + 1) * sizeof(uint32_t));
+    lru->size = 0;
+    lru->head = LRU_NIL;
+    lru->tail = LRU_NIL;
+    lru->owner = NULL;
+}
+
+void ethash_item_lru_clear(ethash_item_lru *lru) {
+    pthread_mutex_lock(&lru->lock);
+    lru_reset(lru);
+    pthread_mutex_unlock(&lru->lock);
+}
+
+void ethash_item_lru_stats(ethash_item_lru *lru, uint64_t *hits, uint64_t *misses) {
+    pthread_mutex_lock(&lru->lock);
+    *hits = lru->hits;
+    *misses = lru->misses;
+    pthread_mutex_unlock(&lru->lock);
+}
+
+static inline uint32_t lru_bucket(ethash_item_lru const *lru, uint32_t index) {
+    return (index * 0x9e3779b1U) & lru->bucket_mask;
+}
+
+static uint32_t lru_find(ethash_item_lru const *lru, uint32_t index) {
+    uint32_t e = lru->buckets[lru_bucket(lru, index)];
+    while (e != LRU_NIL && lru->entries[e].index != index) {
+        e = lru->entries[e].chain;
+    }
+    return e;
+}
+
+static void lru_unlink(ethash_item_lru *lru, uint32_t e) {
+    lru_entry *entry = &lru->entries[e];
+    if (entry->prev != LRU_NIL) {
+        lru->entries[entry->prev].next = entry->next;
+    } else {
+        lru->head = entry->next;
+    }
+    if (entry->next != LRU_NIL) {
+        lru->entries[entry->next].prev = entry->prev;
+    } else {
+        lru->tail = entry->prev;
+    }
+}
+
+static void lru_push_front(ethash_item_lru *lru, uint32_t e) {
+    lru_entry *entry = &lru->entries[e];
+    entry->prev = LRU_NIL;
+    entry->next = lru->head;
+    if (lru->head != LRU_NIL) {
+        lru->entries[lru->head].prev = e;
+    }
+    lru->head = e;
+    if (lru->tail == LRU_NIL) {
+        lru->tail = e;
+    }
+}
+
+static void lru_remove_from_bucket(ethash_item_lru *lru, uint32_t e) {
+    uint32_t *link = &lru->buckets[lru_bucket(lru, lru->entries[e].index)];
+    while (*link != e) {
+        link = &lru->entries[*link].chain;
+    }
+    *link = lru->entries[e].chain;
+}
+
+static bool lru_get(ethash_item_lru *lru, void const *owner, uint32_t index, node *out) {
+    bool found = false;
+    pthread_mutex_lock(&lru->lock);
+    if (lru->owner != owner) {
+        lru_reset(lru);
+        lru->owner = owner;
+    }
+    uint32_t const e = lru_find(lru, index);
+    if (e != LRU_NIL) {
+        *out = lru->entries[e].item;
+        lru_unlink(lru, e);
+        lru_push_front(lru, e);
+        found = true;
+        lru->hits++;
+    } else {
+        lru->misses++;
+    }
+    pthread_mutex_unlock(&lru->lock);
+    return found;
+}
+
+static void lru_put(ethash_item_lru *lru, void const *owner, uint32_t index, node const *item) {
+    pthread_mutex_lock(&lru->lock);
+    // another thread may have derived the same item, or switched epochs, meanwhile
+    if (lru->owner == owner && lru_find(lru, index) == LRU_NIL) {
+        uint32_t e;
+        if (lru->size < lru->capacity) {
+            e = lru->size++;
+        } else {
+            e = lru->tail;
+            lru_unlink(lru, e);
+            lru_remove_from_bucket(lru, e);
+        }
+        lru_entry *entry = &lru->entries[e];
+        entry->item = *item;
+        entry->index = index;
+        uint32_t *bucket = &lru->buckets[lru_bucket(lru, index)];
+        entry->chain = *bucket;
+        *bucket = e;
+        lru_push_front(lru, e);
+    }
+    pthread_mutex_unlock(&lru->lock);
+}
+
+static void ethash_lookup_dag_item(
+        node *const ret,
+        const uint32_t node_index,
+        ethash_params const *params,
+        ethash_cache const *cache,
+        ethash_item_lru *lru) {
+
+    if (lru && lru_get(lru, cache->mem, node_index, ret)) {
+        return;
+    }
+    ethash_calculate_dag_item(ret, node_index, params, cache);
+    if (lru) {
+        lru_put(lru, cache->mem, node_index, ret);
+    }
+}
+
+// pack hash and nonce together into first 40 bytes of s_mix, sha3-512 them
+// and replicate the result across the mix
+static inline void ethash_hash_init(node s_mix[MIX_NODES + 1], const uint8_t header_hash[32], const uint64_t nonce) {
+    assert(sizeof(node) * 8 == 512);
+    memcpy(s_mix[0].bytes, header_hash, 32);
+    s_mix[0].double_words[4] = nonce;
+
+    SHA3_512_40(s_mix->double_words, s_mix->double_words);
+    ethash_mix_init(s_mix[1].words, s_mix[0].words);
+}
+
+static inline uint32_t ethash_page_index(node const s_mix[MIX_NODES + 1], unsigned i, unsigned num_full_pages) {
+    return ethash_mix_index(s_mix[0].words[0], s_mix[1].words, i) % ethash_full_pages(num_full_pages);
+}
+
+static inline void ethash_hash_finish(ethash_return_value *ret, node s_mix[MIX_NODES + 1]) {
+    node *const mix = s_mix + 1;
+
+    // compress mix, in place
+    ethash_mix_compress(mix->words, mix->words);
+
+    memcpy(ret->mix_hash, mix->bytes, 32);
+    // final Keccak hash
+    uint64_t result[4];
+    SHA3_256_96(result, (uint64_t const *) s_mix); // Keccak-256(s + compressed_mix)
+    memcpy(ret->result, result, 32);
+}
+
+// Pages below resident_pages are read from full_nodes, the others derived
+// from the cache: all resident for the full path, none for the light path.
+// Returns the number of pages derived.
+static unsigned ethash_hash_impl(
         ethash_return_value *ret,
         node const *full_nodes,
+        uint32_t resident_pages,
+        ethash_cache const *cache,
+        ethash_item_lru *lru,
         ethash_params const *params,
         const uint8_t header_hash[32],
         const uint64_t nonce) {
 
     assert((params->full_size % MIX_WORDS) == 0);
 
-    // pack hash and nonce together into first 40 bytes of s_mix
-    assert(sizeof(node) * 8 == 512);
     node s_mix[MIX_NODES + 1];
-    memcpy(s_mix[0].bytes, header_hash, 32);
-
-    s_mix[0].double_words[4] = nonce;
+    ethash_hash_init(s_mix, header_hash, nonce);
+    node *const mix = s_mix + 1;
 
-    // compute sha3-512 hash and replicate across mix
-    SHA3_512(s_mix->bytes, s_mix->bytes, 40);
+    unsigned const
+            page_size = sizeof(uint32_t) * MIX_WORDS,
+            num_full_pages = (unsigned) (params->full_size / page_size);
+    unsigned derived = 0;
 
-    node *const mix = s_mix + 1;
-    for (unsigned w = 0; w != MIX_WORDS; ++w) {
-        mix->words[w] = s_mix[0].words[w % NODE_WORDS];
+    for (unsigned i = 0; i != ACCESSES; ++i) {
+        uint32_t const index = ethash_page_index(s_mix, i, num_full_pages);
+        bool const resident = index < resident_pages;
+        derived += !resident;
+
+        node const *page;
+        node derived_page[MIX_NODES];
+        if (resident) {
+            page = &full_nodes[MIX_NODES * index];
+        } else {
+            for (unsigned n = 0; n != MIX_NODES; ++n) {
+                ethash_lookup_dag_item(&derived_page[n], MIX_NODES * index + n, params, cache, lru);
+            }
+            page = derived_page;
+        }
+        ethash_mix_page(mix->words, page->words);
     }
 
+    ethash_hash_finish(ret, s_mix);
+    return derived;
+}
+
+/*
+ * Interleaved scalar hashing: ETHASH_INTERLEAVE independent nonces advance
+ * through the ACCESSES loop together. Every state's next page is prefetched
+ * before any of them is mixed, so up to ETHASH_INTERLEAVE DRAM reads are in
+ * flight instead of one dependent read at a time.
+ */
+
+void ethash_hash_interleaved(
+        ethash_return_value *ret,
+        node const *full_nodes,
+        ethash_params const *params,
+        const uint8_t header_hash[32],
+        uint64_t const *nonces,
+        size_t count) {
+
+    assert(full_nodes != NULL);
+    assert((params->full_size % MIX_WORDS) == 0);
+
     unsigned const
             page_size = sizeof(uint32_t) * MIX_WORDS,
             num_full_pages = (unsigned) (params->full_size / page_size);
 
-    for (unsigned i = 0; i != ACCESSES; ++i) {
-        uint32_t const index = ((s_mix->words[0] ^ i) * FNV_PRIME ^ mix->words[i % MIX_WORDS]) % num_full_pages;
+    for (size_t base = 0; base < count; base += ETHASH_INTERLEAVE) {
+        unsigned const states = count - base < ETHASH_INTERLEAVE ? (unsigned) (count - base) : ETHASH_INTERLEAVE;
+        node s_mix[ETHASH_INTERLEAVE][MIX_NODES + 1];
+        node const *page[ETHASH_INTERLEAVE];
 
-        for (unsigned n = 0; n != MIX_NODES; ++n) {
-            const node *dag_node = &full_nodes[MIX_NODES * index + n];
+        for (unsigned k = 0; k != states; ++k) {
+            ethash_hash_init(s_mix[k], header_hash, nonces[base + k]);
+        }
 
-            for (unsigned w = 0; w != NODE_WORDS; ++w) {
-                mix[n].words[w] = fnv_hash(mix[n].words[w], dag_node->words[w]);
+        for (unsigned i = 0; i != ACCESSES; ++i) {
+            for (unsigned k = 0; k != states; ++k) {
+                page[k] = &full_nodes[MIX_NODES * ethash_page_index(s_mix[k], i, num_full_pages)];
+                for (unsigned n = 0; n != MIX_NODES; ++n) {
+                    __builtin_prefetch(&page[k][n], 0, 0);
+                }
+            }
+            for (unsigned k = 0; k != states; ++k) {
+                ethash_mix_page(s_mix[k][1].words, page[k]->words);
             }
         }
+
+        for (unsigned k = 0; k != states; ++k) {
+            ethash_hash_finish(&ret[base + k], s_mix[k]);
+        }
     }
+}
+
+/*
+ * Lane-parallel batches: ethash_lanes.h instantiated per SIMD width, picked
+ * at runtime from what the CPU supports.
+ */
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define ETHASH_X86_LANES 1
+
+// baseline x86-64 vectors (SSE2)
+#define LANES 4
+#define LANES_FN(name) name##_x4_sse2
+#define LANES_TARGET
+#include "ethash_lanes.h"
+
+// two ymm per state word beat one: the extra independent chain hides latency
+#define LANES 8
+#define LANES_FN(name) name##_x8_avx2
+#define LANES_TARGET __attribute__((target("avx2")))
+#include "ethash_lanes.h"
+
+#define LANES 16
+#define LANES_FN(name) name##_x16_avx512
+#define LANES_TARGET __attribute__((target("avx512f")))
+#include "ethash_lanes.h"
+#endif
 
-    // compress mix
-    for (unsigned w = 0; w != MIX_WORDS; w += 4) {
-        uint32_t reduction = mix->words[w + 0];
-        reduction = reduction * FNV_PRIME ^ mix->words[w + 1];
-        reduction = reduction * FNV_PRIME ^ mix->words[w + 2];
-        reduction = reduction * FNV_PRIME ^ mix->words[w + 3];
-        mix->words[w / 4] = reduction;
+typedef void (*ethash_lanes_fn)(
+        ethash_return_value *ret,
+        node const *full_nodes,
+        ethash_params const *params,
+        const uint8_t header_hash[32],
+        uint64_t const *nonces);
+
+static pthread_once_t batch_once = PTHREAD_ONCE_INIT;
+static ethash_lanes_fn batch_fn = NULL;
+static unsigned batch_lanes = 1;
+
+static void ethash_batch_select(void) {
+#ifdef ETHASH_X86_LANES
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        batch_fn = ethash_hash_x16_avx512;
+        batch_lanes = 16;
+    } else if (__builtin_cpu_supports("avx2")) {
+        batch_fn = ethash_hash_x8_avx2;
+        batch_lanes = 8;
+    } else {
+        batch_fn = ethash_hash_x4_sse2;
+        batch_lanes = 4;
     }
+#endif
+}
 
-    memcpy(ret->mix_hash, mix->bytes, 32);
-    // final Keccak hash
-    SHA3_256(ret->result, s_mix->bytes, 64 + 32); // Keccak-256(s + compressed_mix)
+unsigned ethash_hash_batch_lanes(void) {
+    pthread_once(&batch_once, ethash_batch_select);
+    return batch_lanes;
+}
+
+void ethash_hash_batch(
+        ethash_return_value *ret,
+        node const *full_nodes,
+        ethash_params const *params,
+        const uint8_t header_hash[32],
+        uint64_t const *nonces,
+        size_t count) {
+    assert(full_nodes != NULL);
+    unsigned const lanes = ethash_hash_batch_lanes();
+    size_t i = 0;
+    if (batch_fn) {
+        for (; i + lanes <= count; i += lanes) {
+            batch_fn(ret + i, full_nodes, params, header_hash, nonces + i);
+        }
+    }
+    ethash_hash_interleaved(ret + i, full_nodes, params, header_hash, nonces + i, count - i);
+}
+
+void ethash_hash(
+        ethash_return_value *ret,
+        node const *full_nodes,
+        ethash_params const *params,
+        const uint8_t header_hash[32],
+        const uint64_t nonce) {
+    assert(full_nodes != NULL);
+    ethash_hash_impl(ret, full_nodes, UINT32_MAX, NULL, NULL, params, header_hash, nonce);
+}
+
+void ethash_quick_hash(
+        uint8_t result[32],
+        const uint8_t header_hash[32],
+        const uint64_t nonce,
+        const uint8_t mix_hash[32]) {
+    node s_mix[2];
+    memcpy(s_mix[0].bytes, header_hash, 32);
+    s_mix[0].double_words[4] = nonce;
+    SHA3_512_40(s_mix[0].double_words, s_mix[0].double_words);
+    memcpy(s_mix[1].bytes, mix_hash, 32);
+    uint64_t out[4];
+    SHA3_256_96(out, (uint64_t const *) s_mix);
+    memcpy(result, out, 32);
+}
+
+void ethash_light_compute(
+        ethash_return_value *ret,
+        ethash_cache const *cache,
+        ethash_item_lru *lru,
+        ethash_params const *params,
+        const uint8_t header_hash[32],
+        const uint64_t nonce) {
+    ethash_hash_impl(ret, NULL, 0, cache, lru, params, header_hash, nonce);
+}
+
+/*
+ * Partial DAG: the first resident_pages pages computed up front, the rest
+ * derived from the cache on access. Accesses are uniform over the pages, so
+ * the resident fraction is also the fraction of page reads served from
+ * memory; which pages are kept makes no difference.
+ */
+
+struct ethash_partial_dag {
+    ethash_params params;
+    ethash_cache const *cache;
+    node *resident;
+    uint32_t resident_pages;
+    ethash_item_lru *lru;           // owned, NULL without memoization
+    uint64_t hashes;                // updated with relaxed atomics
+    uint64_t derived_pages;
+};
+
+ethash_partial_dag *ethash_partial_dag_new(
+        ethash_params const *params,
+        ethash_cache const *cache,
+        double resident_fraction,
+        unsigned lru_items) {
+    uint32_t const num_full_pages = (uint32_t) (params->full_size / MIX_BYTES);
+    if (resident_fraction < 0) {
+        resident_fraction = 0;
+    }
+    uint32_t resident_pages = resident_fraction >= 1 ? num_full_pages : (uint32_t) (num_full_pages * resident_fraction);
+
+    ethash_partial_dag *dag = (ethash_partial_dag *) calloc(1, sizeof(ethash_partial_dag));
+    if (!dag) {
+        return NULL;
+    }
+    dag->params = *params;
+    dag->cache = cache;
+    dag->resident_pages = resident_pages;
+    if (resident_pages) {
+        dag->resident = (node *) malloc((size_t) resident_pages * MIX_BYTES);
+        if (!dag->resident) {
+            free(dag);
+            return NULL;
+        }
+    }
+    // an LRU asked for but missing would skew every rate measured through it
+    if (lru_items) {
+        dag->lru = ethash_item_lru_new(lru_items);
+        if (!dag->lru) {
+            free(dag->resident);
+            free(dag);
+            return NULL;
+        }
+    }
+    if (resident_pages) {
+        ethash_compute_items(dag->resident, 0, resident_pages * MIX_NODES, params, cache);
+    }
+    return dag;
+}
+
+void ethash_partial_dag_delete(ethash_partial_dag *dag) {
+    if (!dag) {
+        return;
+    }
+    ethash_item_lru_delete(dag->lru);
+    free(dag->resident);
+    free(dag);
+}
+
+void ethash_partial_hash(
+        ethash_return_value *ret,
+        ethash_partial_dag *dag,
+        const uint8_t header_hash[32],
+        const uint64_t nonce) {
+    unsigned const derived = ethash_hash_impl(ret, dag->resident, dag->resident_pages, dag->cache, dag->lru,
+            &dag->params, header_hash, nonce);
+    __atomic_fetch_add(&dag->hashes, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&dag->derived_pages, derived, __ATOMIC_RELAXED);
+}
+
+void ethash_partial_dag_stats(ethash_partial_dag *dag, ethash_partial_stats *stats) {
+    stats->resident_bytes = (size_t) dag->resident_pages * MIX_BYTES;
+    stats->hashes = __atomic_load_n(&dag->hashes, __ATOMIC_RELAXED);
+    stats->page_reads = stats->hashes * ACCESSES;
+    stats->derived_pages = __atomic_load_n(&dag->derived_pages, __ATOMIC_RELAXED);
+    stats->lru_hits = stats->lru_misses = 0;
+    if (dag->lru) {
+        ethash_item_lru_stats(dag->lru, &stats->lru_hits, &stats->lru_misses);
+    }
+}
+
+unsigned ethash_search(
+        ethash_solution *solutions,
+        unsigned max_solutions,
+        node const *full_nodes,
+        ethash_params const *params,
+        const uint8_t header_hash[32],
+        const uint64_t start_nonce,
+        const uint64_t count,
+        const uint8_t boundary[32]) {
+    assert(full_nodes != NULL);
+    enum { SEARCH_CHUNK = 64 };
+    uint64_t nonces[SEARCH_CHUNK];
+    ethash_return_value values[SEARCH_CHUNK];
+    unsigned found = 0;
+    for (uint64_t base = 0; base < count; base += SEARCH_CHUNK) {
+        size_t const chunk = count - base < SEARCH_CHUNK ? (size_t) (count - base) : SEARCH_CHUNK;
+        for (size_t k = 0; k != chunk; ++k) {
+            nonces[k] = start_nonce + base + k;
+        }
+        ethash_hash_batch(values, full_nodes, params, header_hash, nonces, chunk);
+        for (size_t k = 0; k != chunk; ++k) {
+            if (ethash_check_difficulty(values[k].result, boundary)) {
+                if (found < max_solutions) {
+                    solutions[found].nonce = nonces[k];
+                    solutions[found].value = values[k];
+                }
+                ++found;
+            }
+        }
+    }
+    return found;
 }
@@ -0,0 +1,208 @@
+/*
+  This file is part of ethash.
+
+  ethash is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  ethash is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with cpp-ethereum.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file ethash.h
+* @date 2015
+*/
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define ETHASH_EPOCH_LENGTH 30000U
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef union node node;
+
+typedef struct ethash_params {
+    size_t full_size;               // Size of full data set (in bytes, multiple of mix size (128)).
+    size_t cache_size;              // Size of compute cache (in bytes, multiple of node size (64)).
+} ethash_params;
+
+typedef struct ethash_return_value {
+    uint8_t result[32];
+    uint8_t mix_hash[32];
+} ethash_return_value;
+
+typedef struct ethash_cache {
+    void *mem;                      // cache_size bytes, owned by the caller
+} ethash_cache;
+
+// sizes for the epoch containing block_number; tabulated for the first 2048
+// epochs, prime-searched after that
+uint64_t ethash_get_full_size(const uint32_t block_number);
+uint64_t ethash_get_cache_size(const uint32_t block_number);
+ethash_params ethash_get_params(const uint32_t block_number);
+
+// seed hash for the epoch containing block_number
+void ethash_get_seedhash(uint8_t seedhash[32], const uint32_t block_number);
+
+// the epoch whose seed hash is seedhash, searching the first max_epochs; -1
+// when there is none, for work that names its DAG only by seed
+int32_t ethash_get_seedhash_epoch(const uint8_t seedhash[32], const uint32_t max_epochs);
+
+// fills cache->mem (params->cache_size bytes) from the epoch seed hash
+void ethash_mkcache(ethash_cache *cache, ethash_params const *params, const uint8_t seed[32]);
+
+// fills mem (params->full_size bytes) from the cache, using all online cores
+void ethash_compute_full_data(void *mem, ethash_params const *params, ethash_cache const *cache);
+
+// the same for bytes [begin, end) of mem only, both multiples of 64; lets a
+// DAG be produced, and consumed, in chunks
+void ethash_compute_full_data_range(void *mem, ethash_params const *params, ethash_cache const *cache, size_t begin, size_t end);
+
+void ethash_hash(
+        ethash_return_value *ret,
+        node const *full_nodes,
+        ethash_params const *params,
+        const uint8_t header_hash[32],
+        const uint64_t nonce);
+
+// Bytes of DAG read per hash: ACCESSES (64) pages of MIX_BYTES (128).
+#define ETHASH_DAG_BYTES_PER_HASH (64U * 128U)
+
+// Independent hash states ethash_hash_interleaved keeps in flight.
+#define ETHASH_INTERLEAVE 16
+
+// ret[i] = ethash_hash(nonces[i]); scalar, but with ETHASH_INTERLEAVE nonces
+// interleaved and their DAG pages prefetched to overlap memory latency.
+void ethash_hash_interleaved(
+        ethash_return_value *ret,
+        node const *full_nodes,
+        ethash_params const *params,
+        const uint8_t header_hash[32],
+        uint64_t const *nonces,
+        size_t count);
+
+// ret[i] = ethash_hash(nonces[i]), several nonces per step in SIMD lanes
+// (16 on AVX-512, 8 on AVX2, 4 on baseline x86-64, chosen at runtime), with
+// ethash_hash_interleaved elsewhere and for the tail.
+void ethash_hash_batch(
+        ethash_return_value *ret,
+        node const *full_nodes,
+        ethash_params const *params,
+        const uint8_t header_hash[32],
+        uint64_t const *nonces,
+        size_t count);
+
+// nonces per SIMD step of ethash_hash_batch on this CPU, 1 when scalar
+unsigned ethash_hash_batch_lanes(void);
+
+// 1 when hash <= boundary, both read as 256-bit big-endian numbers
+static inline int ethash_check_difficulty(const uint8_t hash[32], const uint8_t boundary[32]) {
+    for (int i = 0; i < 32; i++) {
+        if (hash[i] == boundary[i]) {
+            continue;
+        }
+        return hash[i] < boundary[i];
+    }
+    return 1;
+}
+
+typedef struct ethash_solution {
+    uint64_t nonce;
+    ethash_return_value value;
+} ethash_solution;
+
+// Hashes count nonces starting at start_nonce and keeps the first max_solutions
+// whose result meets boundary. Returns the total number of hits, which may
+// exceed max_solutions.
+unsigned ethash_search(
+        ethash_solution *solutions,
+        unsigned max_solutions,
+        node const *full_nodes,
+        ethash_params const *params,
+        const uint8_t header_hash[32],
+        const uint64_t start_nonce,
+        const uint64_t count,
+        const uint8_t boundary[32]);
+
+// Optional memo of recently derived dataset items for ethash_light_compute.
+// Safe to share between threads; flushed automatically when used with a
+// different cache. NULL for a capacity of 0 or one too large to index.
+typedef struct ethash_item_lru ethash_item_lru;
+
+ethash_item_lru *ethash_item_lru_new(unsigned capacity);
+void ethash_item_lru_delete(ethash_item_lru *lru);
+void ethash_item_lru_clear(ethash_item_lru *lru);
+
+// lookups served from the memo, and those that had to derive the item
+void ethash_item_lru_stats(ethash_item_lru *lru, uint64_t *hits, uint64_t *misses);
+
+// The final Keccak of ethash_hash from a claimed mix_hash, without touching
+// the DAG: equal to ethash_hash's result when mix_hash is the real one, so a
+// share whose quick hash misses its boundary can be rejected for two Keccaks.
+void ethash_quick_hash(
+        uint8_t result[32],
+        const uint8_t header_hash[32],
+        const uint64_t nonce,
+        const uint8_t mix_hash[32]);
+
+// Same result as ethash_hash, deriving the accessed pages from the cache alone.
+// lru may be NULL.
+void ethash_light_compute(
+        ethash_return_value *ret,
+        ethash_cache const *cache,
+        ethash_item_lru *lru,
+        ethash_params const *params,
+        const uint8_t header_hash[32],
+        const uint64_t nonce);
+
+// Between the full and the light path: the first resident_fraction of the
+// DAG's pages is computed up front and kept, any other page is derived from
+// the cache when read, through an LRU of lru_items items (0 for none). Hash
+// rate falls with the fraction of pages derived, and memory with it. cache
+// must outlive the partial DAG. NULL when out of memory, or when lru_items
+// is more than ethash_item_lru_new takes.
+typedef struct ethash_partial_dag ethash_partial_dag;
+
+typedef struct ethash_partial_stats {
+    size_t resident_bytes;
+    uint64_t hashes;
+    uint64_t page_reads;            // ACCESSES per hash
+    uint64_t derived_pages;         // of those, not resident
+    uint64_t lru_hits;              // item lookups for derived pages (two per page)
+    uint64_t lru_misses;
+} ethash_partial_stats;
+
+ethash_partial_dag *ethash_partial_dag_new(
+        ethash_params const *params,
+        ethash_cache const *cache,
+        double resident_fraction,
+        unsigned lru_items);
+void ethash_partial_dag_delete(ethash_partial_dag *dag);
+
+// Same result as ethash_hash; safe to call from several threads at once.
+void ethash_partial_hash(
+        ethash_return_value *ret,
+        ethash_partial_dag *dag,
+        const uint8_t header_hash[32],
+        const uint64_t nonce);
+
+void ethash_partial_dag_stats(ethash_partial_dag *dag, ethash_partial_stats *stats);
+
+// Known-answer checks (Keccak, seed hashes, epoch sizes) and every hashing
+// path checked bit-exact to ethash_hash on a tiny dataset, in milliseconds;
+// with published != 0 also the epoch 0 block 22 vector, about a second.
+// Returns 0, or -1 with the first failure described in err. (selftest.c)
+int ethash_self_test(int published, char *err, size_t err_len);
+
+#ifdef __cplusplus
+}
+#endif
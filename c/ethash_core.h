@@ -0,0 +1,135 @@
+/*
+  This file is part of ethash.
+
+  ethash is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  ethash is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with ethash.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file ethash_core.h
+* @date 2026
+*
+* The Ethash arithmetic shared by every target: the algorithm constants,
+* FNV, the round-unrolled Keccak-f[1600] with the fixed-length single-block
+* Keccaks built on it, and the hashimoto mix steps (ethash_mix.h). Header
+* only, and valid both as C99 for ethash.c and as OpenCL C for
+* ocl/krnl_ethash.cl, so a change here lands on the CPU, SIMD and FPGA
+* paths at once. How DAG pages are fetched and how nonces are scheduled
+* stays with each target.
+*
+* Compile-time specialization: MIX_BYTES, ACCESSES, DATASET_PARENTS and
+* CACHE_ROUNDS may be defined before including (an Ethash variant), and
+* ETHASH_FULL_PAGES folds the page count of a single-epoch build into a
+* constant.
+*/
+#ifndef ETHASH_CORE_H
+#define ETHASH_CORE_H
+
+#ifdef __OPENCL_VERSION__
+typedef uchar uint8_t;
+typedef uint uint32_t;
+typedef ulong uint64_t;
+#define ETHASH_CONSTANT constant
+#else
+#include <stdint.h>
+#define ETHASH_CONSTANT static const
+#endif
+
+#ifndef MIX_BYTES
+#define MIX_BYTES 128
+#endif
+#ifndef ACCESSES
+#define ACCESSES 64
+#endif
+#ifndef DATASET_PARENTS
+#define DATASET_PARENTS 256
+#endif
+#ifndef CACHE_ROUNDS
+#define CACHE_ROUNDS 3
+#endif
+#define HASH_BYTES 64
+#define NODE_WORDS (HASH_BYTES / 4)
+#define MIX_WORDS (MIX_BYTES / 4)
+#define MIX_NODES (MIX_WORDS / NODE_WORDS)
+
+#if MIX_BYTES % HASH_BYTES != 0 || MIX_WORDS % 4 != 0
+#error "MIX_BYTES must be a multiple of HASH_BYTES"
+#endif
+
+// pages in the DAG: the runtime count, or the constant of a one-epoch build
+#ifdef ETHASH_FULL_PAGES
+#define ethash_full_pages(num_full_pages) ((uint32_t) (ETHASH_FULL_PAGES))
+#else
+#define ethash_full_pages(num_full_pages) (num_full_pages)
+#endif
+
+#define FNV_PRIME 0x01000193
+
+static inline uint32_t fnv_hash(const uint32_t x, const uint32_t y) {
+    return x * FNV_PRIME ^ y;
+}
+
+/*
+ * Keccak-f[1600] on 64-bit words, and Keccak over inputs that fit in one
+ * block (40-byte header+nonce, 64-byte node, 96-byte seed+mix): absorb and
+ * squeeze are plain word copies around the permutation. Little-endian only,
+ * like the rest of the word views.
+ */
+
+ETHASH_CONSTANT uint64_t RC[24] = {
+        1ULL, 0x8082ULL, 0x800000000000808aULL, 0x8000000080008000ULL,
+        0x808bULL, 0x80000001ULL, 0x8000000080008081ULL, 0x8000000000008009ULL,
+        0x8aULL, 0x88ULL, 0x80008009ULL, 0x8000000aULL,
+        0x8000808bULL, 0x800000000000008bULL, 0x8000000000008089ULL, 0x8000000000008003ULL,
+        0x8000000000008002ULL, 0x8000000000000080ULL, 0x800aULL, 0x800000008000000aULL,
+        0x8000000080008081ULL, 0x8000000000008080ULL, 0x80000001ULL, 0x8000000080008008ULL};
+
+#define rol(x, s) (((x) << s) | ((x) >> (64 - s)))
+
+#define KECCAK_WORD uint64_t
+#define KECCAK_FN keccakf1600
+#include "keccakf1600.h"
+
+static inline void sha3_single_block(
+        uint64_t *out, unsigned out_words,
+        uint64_t const *in, unsigned in_words,
+        unsigned rate_words) {
+    uint64_t a[25];
+    for (unsigned i = 0; i != 25; ++i) {
+        a[i] = i < in_words ? in[i] : 0;
+    }
+    a[in_words] ^= 0x01;
+    a[rate_words - 1] ^= 0x8000000000000000ULL;
+    keccakf1600(a);
+    for (unsigned i = 0; i != out_words; ++i) {
+        out[i] = a[i];
+    }
+}
+
+// out may alias in
+static inline void SHA3_512_40(uint64_t *ret, uint64_t const *data) {
+    sha3_single_block(ret, 8, data, 5, 9);
+}
+
+static inline void SHA3_512_64(uint64_t *ret, uint64_t const *data) {
+    sha3_single_block(ret, 8, data, 8, 9);
+}
+
+static inline void SHA3_256_96(uint64_t *ret, uint64_t const *data) {
+    sha3_single_block(ret, 4, data, 12, 17);
+}
+
+// one nonce: ethash_mix_init, ethash_mix_index, ethash_mix_page, ethash_mix_compress
+#define MIX_WORD uint32_t
+#define MIX_FN(name) ethash_##name
+#include "ethash_mix.h"
+
+#endif
@@ -0,0 +1,130 @@
+/*
+  This file is part of ethash.
+
+  ethash is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  ethash is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with ethash.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file ethash_lanes.h
+* @date 2026
+*
+* ethash_hash over LANES nonces at once, one nonce per vector lane: both
+* Keccak calls, the FNV mix and the compression run on GCC vectors, with the
+* permutation and mix steps of ethash_core.h instantiated for them.
+* Included by ethash.c once per width with LANES, LANES_FN(name) and
+* LANES_TARGET (a target attribute, or empty) defined.
+*/
+
+typedef uint64_t LANES_FN(v64) __attribute__((vector_size(LANES * 8)));
+typedef uint32_t LANES_FN(v32) __attribute__((vector_size(LANES * 4)));
+
+#define KECCAK_WORD LANES_FN(v64)
+#define KECCAK_FN LANES_FN(keccakf1600)
+#define KECCAK_ATTR LANES_TARGET
+#include "keccakf1600.h"
+
+#define MIX_WORD LANES_FN(v32)
+#define MIX_FN LANES_FN
+#define MIX_ATTR LANES_TARGET
+#include "ethash_mix.h"
+
+LANES_TARGET
+static void LANES_FN(ethash_hash)(
+        ethash_return_value *ret,
+        node const *full_nodes,
+        ethash_params const *params,
+        const uint8_t header_hash[32],
+        uint64_t const *nonces) {
+
+    typedef LANES_FN(v64) v64;
+    typedef LANES_FN(v32) v32;
+
+    // Keccak-512(header || nonce), one 40-byte single-block absorb per lane
+    v64 st[25];
+    for (unsigned i = 0; i != 25; ++i) {
+        st[i] = (v64) {0};
+    }
+    for (unsigned i = 0; i != 4; ++i) {
+        uint64_t word;
+        memcpy(&word, header_hash + 8 * i, 8);
+        st[i] += word;
+    }
+    for (unsigned l = 0; l != LANES; ++l) {
+        st[4][l] = nonces[l];
+    }
+    st[5] ^= 0x01;
+    st[8] ^= 0x8000000000000000ULL;
+    LANES_FN(keccakf1600)(st);
+
+    v64 seed[8];
+    v32 s[NODE_WORDS];
+    for (unsigned i = 0; i != 8; ++i) {
+        seed[i] = st[i];
+        s[2 * i] = __builtin_convertvector(st[i], v32);
+        s[2 * i + 1] = __builtin_convertvector(st[i] >> 32, v32);
+    }
+
+    v32 mix[MIX_WORDS];
+    LANES_FN(mix_init)(mix, s);
+
+    unsigned const
+            page_size = sizeof(uint32_t) * MIX_WORDS,
+            num_full_pages = ethash_full_pages((unsigned) (params->full_size / page_size));
+
+    for (unsigned i = 0; i != ACCESSES; ++i) {
+        v32 const index = LANES_FN(mix_index)(s[0], mix, i);
+        uint32_t const *page[LANES];
+        for (unsigned l = 0; l != LANES; ++l) {
+            page[l] = full_nodes[MIX_NODES * (index[l] % num_full_pages)].words;
+        }
+        // gathered: word w of every lane's page
+        v32 dag_words[MIX_WORDS];
+        for (unsigned w = 0; w != MIX_WORDS; ++w) {
+            for (unsigned l = 0; l != LANES; ++l) {
+                dag_words[w][l] = page[l][w];
+            }
+        }
+        LANES_FN(mix_page)(mix, dag_words);
+    }
+
+    v32 cmix[MIX_WORDS / 4];
+    LANES_FN(mix_compress)(cmix, mix);
+
+    // Keccak-256(s || compressed mix), 96-byte single-block absorb
+    for (unsigned i = 0; i != 8; ++i) {
+        st[i] = seed[i];
+    }
+    for (unsigned i = 0; i != 4; ++i) {
+        st[8 + i] = __builtin_convertvector(cmix[2 * i], v64) | __builtin_convertvector(cmix[2 * i + 1], v64) << 32;
+    }
+    for (unsigned i = 12; i != 25; ++i) {
+        st[i] = (v64) {0};
+    }
+    st[12] ^= 0x01;
+    st[16] ^= 0x8000000000000000ULL;
+    LANES_FN(keccakf1600)(st);
+
+    for (unsigned l = 0; l != LANES; ++l) {
+        for (unsigned w = 0; w != 8; ++w) {
+            uint32_t const word = cmix[w][l];
+            memcpy(ret[l].mix_hash + 4 * w, &word, 4);
+        }
+        for (unsigned i = 0; i != 4; ++i) {
+            uint64_t const word = st[i][l];
+            memcpy(ret[l].result + 8 * i, &word, 8);
+        }
+    }
+}
+
+#undef LANES
+#undef LANES_FN
+#undef LANES_TARGET
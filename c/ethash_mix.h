@@ -0,0 +1,66 @@
+/*
+  This file is part of ethash.
+
+  ethash is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  ethash is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with ethash.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file ethash_mix.h
+* @date 2026
+*
+* The hashimoto loop's 32-bit arithmetic, instantiated once per word type:
+* uint32_t for one nonce, a GCC vector for one nonce per lane, OpenCL's uint
+* on the device. A target's loop is
+*
+*   mix_init(mix, seed);
+*   for (i = 0; i != ACCESSES; ++i)
+*       mix_page(mix, page(mix_index(seed[0], mix, i) % num_full_pages));
+*   mix_compress(cmix, mix);
+*
+* with page() and the scheduling of nonces its own. Define MIX_WORD,
+* MIX_FN(name) and optionally MIX_ATTR before including; the constants come
+* from ethash_core.h.
+*/
+
+#ifndef MIX_ATTR
+#define MIX_ATTR
+#endif
+
+// the 512-bit seed replicated across the mix
+MIX_ATTR static inline void MIX_FN(mix_init)(MIX_WORD *mix, MIX_WORD const *seed) {
+    for (unsigned w = 0; w != MIX_WORDS; ++w) {
+        mix[w] = seed[w % NODE_WORDS];
+    }
+}
+
+// page index of access i, before reduction by the page count
+MIX_ATTR static inline MIX_WORD MIX_FN(mix_index)(MIX_WORD seed0, MIX_WORD const *mix, unsigned i) {
+    return (seed0 ^ i) * FNV_PRIME ^ mix[i % MIX_WORDS];
+}
+
+// folds the MIX_WORDS words of a page into the mix
+MIX_ATTR static inline void MIX_FN(mix_page)(MIX_WORD *mix, MIX_WORD const *page) {
+    for (unsigned w = 0; w != MIX_WORDS; ++w) {
+        mix[w] = mix[w] * FNV_PRIME ^ page[w];
+    }
+}
+
+// mix reduced from MIX_WORDS to MIX_WORDS / 4 words; cmix may alias mix
+MIX_ATTR static inline void MIX_FN(mix_compress)(MIX_WORD *cmix, MIX_WORD const *mix) {
+    for (unsigned w = 0; w != MIX_WORDS; w += 4) {
+        cmix[w / 4] = ((mix[w] * FNV_PRIME ^ mix[w + 1]) * FNV_PRIME ^ mix[w + 2]) * FNV_PRIME ^ mix[w + 3];
+    }
+}
+
+#undef MIX_WORD
+#undef MIX_FN
+#undef MIX_ATTR
@@ -0,0 +1,324 @@
+/*
+  This file is part of ethash.
+
+  ethash is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  ethash is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with ethash.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file io.c
+* @date 2026
+*/
+
+#define _GNU_SOURCE
+#include <errno.h>
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "ethash.h"
+#include "io.h"
+
+#define CHECKSUM_PRIME 0x100000001b3ULL
+#define DAG_PATH_MAX 4096
+#define PAGE_BYTES 4096
+
+static uint64_t mix64(uint64_t x) {
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return x;
+}
+
+// Four independent FNV-1a style lanes over 64-bit words so it runs at memory
+// speed. Each step is a bijection of the lane state, so any single changed
+// word always changes the result; this guards against truncation and disk
+// corruption, not tampering. Taken in pieces while a file is streamed: every
+// piece but the last must be a multiple of four words, which whole pages are.
+static void checksum_init(uint64_t h[4]) {
+    h[0] = 0xcbf29ce484222325ULL;
+    h[1] = 0x84222325cbf29ce4ULL;
+    h[2] = 0x9ce484222325cbf2ULL;
+    h[3] = 0x2325cbf29ce48422ULL;
+}
+
+static void checksum_update(uint64_t h[4], void const *data, size_t size) {
+    uint64_t const *words = (uint64_t const *) data;
+    size_t const num_words = size / 8;
+    size_t i = 0;
+    for (; i + 4 <= num_words; i += 4) {
+        h[0] = (h[0] ^ words[i + 0]) * CHECKSUM_PRIME;
+        h[1] = (h[1] ^ words[i + 1]) * CHECKSUM_PRIME;
+        h[2] = (h[2] ^ words[i + 2]) * CHECKSUM_PRIME;
+        h[3] = (h[3] ^ words[i + 3]) * CHECKSUM_PRIME;
+    }
+    for (; i < num_words; ++i) {
+        h[0] = (h[0] ^ words[i]) * CHECKSUM_PRIME;
+    }
+}
+
+static uint64_t checksum_final(uint64_t const h[4], size_t size) {
+    uint64_t result = mix64(size);
+    for (unsigned k = 0; k != 4; ++k) {
+        result = mix64(result ^ h[k]);
+    }
+    return result;
+}
+
+uint64_t ethash_dag_checksum(void const *data, size_t size) {
+    uint64_t h[4];
+    checksum_init(h);
+    checksum_update(h, data, size);
+    return checksum_final(h, size);
+}
+
+void ethash_dag_path(char *path, size_t path_size, char const *dir, uint32_t block_number) {
+    uint8_t seed[32];
+    ethash_get_seedhash(seed, block_number);
+    snprintf(path, path_size, "%s/full-R%u-%02x%02x%02x%02x%02x%02x%02x%02x",
+            dir, ETHASH_DAG_VERSION,
+            seed[0], seed[1], seed[2], seed[3], seed[4], seed[5], seed[6], seed[7]);
+}
+
+const char *ethash_io_rc_name(ethash_io_rc rc) {
+    switch (rc) {
+    case ETHASH_IO_OK: return "ok";
+    case ETHASH_IO_MISSING: return "missing";
+    case ETHASH_IO_MISMATCH: return "stale";
+    case ETHASH_IO_CORRUPT: return "corrupt";
+    default: return "io error";
+    }
+}
+
+static void expected_header(ethash_dag_file_header *header, uint32_t block_number) {
+    ethash_params const params = ethash_get_params(block_number);
+    memset(header, 0, sizeof(*header));
+    memcpy(header->magic, ETHASH_DAG_MAGIC, sizeof(header->magic));
+    header->version = ETHASH_DAG_VERSION;
+    header->epoch = block_number / ETHASH_EPOCH_LENGTH;
+    ethash_get_seedhash(header->seed, block_number);
+    header->full_size = params.full_size;
+    header->cache_size = params.cache_size;
+}
+
+void ethash_dag_close(ethash_dag_file *file) {
+    if (file->map) {
+        munmap(file->map, file->map_size);
+    }
+    memset(file, 0, sizeof(*file));
+}
+
+// ethash_dag_open, leaving the checksum to the caller when verify is 0
+static ethash_io_rc open_file(ethash_dag_file *file, char const *path, uint32_t block_number, int flags, int verify) {
+    memset(file, 0, sizeof(*file));
+
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) {
+        return errno == ENOENT ? ETHASH_IO_MISSING : ETHASH_IO_FAIL;
+    }
+    struct stat st;
+    if (fstat(fd, &st) != 0) {
+        close(fd);
+        return ETHASH_IO_FAIL;
+    }
+    if ((size_t) st.st_size < ETHASH_DAG_HEADER_SIZE) {
+        close(fd);
+        return ETHASH_IO_CORRUPT;
+    }
+
+    // private and writable so runtimes that pin host pages for DMA accept it;
+    // nothing writes to it, so no page is ever copied
+    int const map_flags = MAP_PRIVATE | ((flags & ETHASH_DAG_POPULATE) ? MAP_POPULATE : 0);
+    void *map = mmap(NULL, (size_t) st.st_size, PROT_READ | PROT_WRITE, map_flags, fd, 0);
+    close(fd);
+    if (map == MAP_FAILED) {
+        return ETHASH_IO_FAIL;
+    }
+    file->map = map;
+    file->map_size = (size_t) st.st_size;
+    file->data = (uint8_t *) map + ETHASH_DAG_HEADER_SIZE;
+    memcpy(&file->header, map, sizeof(file->header));
+
+    ethash_dag_file_header expected;
+    expected_header(&expected, block_number);
+    ethash_dag_file_header const *header = &file->header;
+
+    ethash_io_rc rc = ETHASH_IO_OK;
+    if (memcmp(header->magic, expected.magic, sizeof(header->magic)) != 0 || header->version != expected.version) {
+        rc = ETHASH_IO_CORRUPT;
+    } else if (header->epoch != expected.epoch
+            || memcmp(header->seed, expected.seed, sizeof(expected.seed)) != 0
+            || header->full_size != expected.full_size
+            || header->cache_size != expected.cache_size) {
+        rc = ETHASH_IO_MISMATCH;
+    } else if (file->map_size != ETHASH_DAG_HEADER_SIZE + header->full_size) {
+        rc = ETHASH_IO_CORRUPT;
+    } else if (verify && ethash_dag_checksum(file->data, header->full_size) != header->checksum) {
+        rc = ETHASH_IO_CORRUPT;
+    }
+    if (rc != ETHASH_IO_OK) {
+        ethash_dag_close(file);
+    }
+    return rc;
+}
+
+ethash_io_rc ethash_dag_open(ethash_dag_file *file, char const *path, uint32_t block_number, int flags) {
+    return open_file(file, path, block_number, flags, !(flags & ETHASH_DAG_NO_VERIFY));
+}
+
+// Faults in bytes [begin, end) of a file mapping, a read per page, with the
+// kernel already reading ahead the next chunk [end, next_end).
+static void fault_in(uint8_t const *data, size_t begin, size_t end, size_t next_end) {
+    if (next_end > end) {
+        madvise((void *) (data + end), next_end - end, MADV_WILLNEED);
+    }
+    volatile uint8_t const *bytes = data;
+    for (size_t offset = begin; offset < end; offset += PAGE_BYTES) {
+        (void) bytes[offset];
+    }
+}
+
+// Checksums the file as it faults it in, unless told not to. Every chunk is
+// reported as it is read, but the last only once the checksum matches: a
+// corrupt file never completes, and is removed so the next attempt
+// generates it afresh.
+static ethash_io_rc stream_existing(ethash_dag_file *file, char const *path, int verify,
+        size_t chunk_bytes, ethash_dag_progress_fn progress, void *arg) {
+    size_t const full_size = file->header.full_size;
+    uint8_t const *data = (uint8_t const *) file->data;
+    uint64_t h[4];
+    checksum_init(h);
+    progress(arg, file, 0);
+    for (size_t begin = 0; begin < full_size; begin += chunk_bytes) {
+        size_t const end = full_size - begin > chunk_bytes ? begin + chunk_bytes : full_size;
+        size_t const next_end = full_size - end > chunk_bytes ? end + chunk_bytes : full_size;
+        fault_in(data, begin, end, next_end);
+        if (verify) {
+            checksum_update(h, data + begin, end - begin);
+        }
+        if (end != full_size) {
+            progress(arg, file, end);
+        }
+    }
+    if (verify && checksum_final(h, full_size) != file->header.checksum) {
+        unlink(path);
+        return ETHASH_IO_CORRUPT;
+    }
+    progress(arg, file, full_size);
+    return ETHASH_IO_OK;
+}
+
+// Generates the DAG into a temporary file mapped as file, chunk by chunk,
+// and renames it into place once checksummed and synced. The mapping is kept
+// as the opened DAG.
+static ethash_io_rc generate(ethash_dag_file *file, char const *path, uint32_t block_number,
+        size_t chunk_bytes, ethash_dag_progress_fn progress, void *arg) {
+    ethash_dag_file_header header;
+    expected_header(&header, block_number);
+    size_t const file_size = ETHASH_DAG_HEADER_SIZE + header.full_size;
+
+    char tmp_path[DAG_PATH_MAX + 8];
+    snprintf(tmp_path, sizeof(tmp_path), "%s.tmp", path);
+    int fd = open(tmp_path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        return ETHASH_IO_FAIL;
+    }
+    if (ftruncate(fd, (off_t) file_size) != 0) {
+        close(fd);
+        unlink(tmp_path);
+        return ETHASH_IO_FAIL;
+    }
+    uint8_t *map = (uint8_t *) mmap(NULL, file_size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (map == MAP_FAILED) {
+        close(fd);
+        unlink(tmp_path);
+        return ETHASH_IO_FAIL;
+    }
+
+    ethash_params const params = ethash_get_params(block_number);
+    ethash_cache cache;
+    cache.mem = malloc(params.cache_size);
+    if (!cache.mem) {
+        munmap(map, file_size);
+        close(fd);
+        unlink(tmp_path);
+        return ETHASH_IO_FAIL;
+    }
+    file->map = map;
+    file->map_size = file_size;
+    file->data = map + ETHASH_DAG_HEADER_SIZE;
+    file->header = header;
+    if (progress) {
+        progress(arg, file, 0);
+    }
+
+    ethash_mkcache(&cache, &params, header.seed);
+    for (size_t begin = 0; begin < header.full_size; begin += chunk_bytes) {
+        size_t const end = header.full_size - begin > chunk_bytes ? begin + chunk_bytes : header.full_size;
+        ethash_compute_full_data_range(file->data, &params, &cache, begin, end);
+        if (progress) {
+            progress(arg, file, end);
+        }
+    }
+    free(cache.mem);
+
+    // header last, so a crash mid-way never leaves a file that validates
+    header.checksum = ethash_dag_checksum(file->data, header.full_size);
+    memcpy(map, &header, sizeof(header));
+    file->header = header;
+
+    int const synced = msync(map, file_size, MS_SYNC) == 0 && fsync(fd) == 0;
+    close(fd);
+    if (!synced || rename(tmp_path, path) != 0) {
+        unlink(tmp_path);
+        if (!progress) {
+            ethash_dag_close(file);
+        }
+        return ETHASH_IO_FAIL;
+    }
+    return ETHASH_IO_OK;
+}
+
+ethash_io_rc ethash_dag_stream(ethash_dag_file *file, char const *dir, uint32_t block_number, int flags,
+        size_t chunk_bytes, ethash_dag_progress_fn progress, void *arg) {
+    char path[DAG_PATH_MAX];
+    ethash_dag_path(path, sizeof(path), dir, block_number);
+
+    // whole pages, so every chunk after the first starts page-aligned
+    size_t const full_size = ethash_get_full_size(block_number);
+    if (chunk_bytes == 0 || chunk_bytes > full_size) {
+        chunk_bytes = full_size;
+    }
+    chunk_bytes = (chunk_bytes + PAGE_BYTES - 1) / PAGE_BYTES * PAGE_BYTES;
+
+    // streamed, the checksum is taken on the way instead of up front
+    int const verify = !(flags & ETHASH_DAG_NO_VERIFY);
+    ethash_io_rc rc = open_file(file, path, block_number, flags, verify && !progress);
+    if (rc == ETHASH_IO_OK) {
+        if (progress) {
+            rc = stream_existing(file, path, verify, chunk_bytes, progress, arg);
+        }
+        return rc;
+    }
+    if (rc == ETHASH_IO_FAIL) {
+        return rc;
+    }
+    return generate(file, path, block_number, chunk_bytes, progress, arg);
+}
+
+ethash_io_rc ethash_dag_prepare(ethash_dag_file *file, char const *dir, uint32_t block_number, int flags) {
+    return ethash_dag_stream(file, dir, block_number, flags, 0, NULL, NULL);
+}
@@ -0,0 +1,103 @@
+/*
+  This file is part of ethash.
+
+  ethash is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  ethash is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with ethash.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file io.h
+* @date 2026
+*
+* On-disk DAG: a one-page header recording epoch, seed hash, sizes and a
+* checksum, followed by the full dataset. The data starts page-aligned so a
+* mapping of the file can be used as full_nodes, or given to OpenCL with
+* CL_MEM_USE_HOST_PTR, without copying.
+*/
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define ETHASH_DAG_MAGIC "ETHASHDG"
+#define ETHASH_DAG_VERSION 1U
+#define ETHASH_DAG_HEADER_SIZE 4096U
+
+typedef struct ethash_dag_file_header {
+    char magic[8];
+    uint32_t version;
+    uint32_t epoch;
+    uint8_t seed[32];
+    uint64_t full_size;
+    uint64_t cache_size;
+    uint64_t checksum;              // ethash_dag_checksum of the full_size data bytes
+} ethash_dag_file_header;
+
+typedef enum ethash_io_rc {
+    ETHASH_IO_OK = 0,
+    ETHASH_IO_MISSING,              // no file at the path
+    ETHASH_IO_MISMATCH,             // a valid DAG, but for another epoch, seed or size
+    ETHASH_IO_CORRUPT,              // bad magic/version, truncated, or checksum mismatch
+    ETHASH_IO_FAIL                  // system call failed
+} ethash_io_rc;
+
+// flags
+#define ETHASH_DAG_NO_VERIFY 1      // trust an existing file: skip its checksum, which reads all of it
+#define ETHASH_DAG_POPULATE 2       // prefault the mapping on open
+
+typedef struct ethash_dag_file {
+    void *map;
+    size_t map_size;
+    void *data;                     // full_size bytes of DAG, page-aligned
+    ethash_dag_file_header header;
+} ethash_dag_file;
+
+uint64_t ethash_dag_checksum(void const *data, size_t size);
+
+// "<dir>/full-R<version>-<first 8 seed bytes in hex>"
+void ethash_dag_path(char *path, size_t path_size, char const *dir, uint32_t block_number);
+
+// Maps and validates an existing DAG file for the epoch of block_number,
+// checksum included unless ETHASH_DAG_NO_VERIFY.
+ethash_io_rc ethash_dag_open(ethash_dag_file *file, char const *path, uint32_t block_number, int flags);
+
+// Opens the epoch's DAG from dir, or generates it and persists it there
+// (written to a temporary file and renamed into place) when it is missing,
+// stale or corrupt.
+ethash_io_rc ethash_dag_prepare(ethash_dag_file *file, char const *dir, uint32_t block_number, int flags);
+
+// Called while a DAG is streamed: first with ready == 0 once file->data is
+// mapped, then each time another chunk is final, with bytes [0, ready) of
+// file->data final; the last call has ready == full_size.
+typedef void (*ethash_dag_progress_fn)(void *arg, ethash_dag_file const *file, size_t ready);
+
+// ethash_dag_prepare chunk_bytes at a time: an existing file is faulted in,
+// a missing one generated, chunk by chunk in order, with progress called
+// after each, so a consumer can upload what is final while the next chunk is
+// read or computed. An existing file is checksummed on the way, unless
+// ETHASH_DAG_NO_VERIFY, and progress only reaches full_size once it matches;
+// on a mismatch the file is removed and ETHASH_IO_CORRUPT returned, so
+// streaming it again generates it afresh. Once progress has seen the mapping
+// it stays until ethash_dag_close, even on failure.
+ethash_io_rc ethash_dag_stream(ethash_dag_file *file, char const *dir, uint32_t block_number, int flags,
+        size_t chunk_bytes, ethash_dag_progress_fn progress, void *arg);
+
+void ethash_dag_close(ethash_dag_file *file);
+
+const char *ethash_io_rc_name(ethash_io_rc rc);
+
+#ifdef __cplusplus
+}
+#endif
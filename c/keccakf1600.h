@@ -0,0 +1,174 @@
+/*
+  This file is part of ethash.
+
+  ethash is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  ethash is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with ethash.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file keccakf1600.h
+* @date 2026
+*
+* Round-unrolled Keccak-f[1600], instantiated once per lane type. Define
+* KECCAK_WORD (uint64_t or a GCC vector of them), KECCAK_FN and optionally
+* KECCAK_ATTR before including; rol() and RC[] come from the includer.
+*/
+
+#ifndef KECCAK_ATTR
+#define KECCAK_ATTR
+#endif
+
+KECCAK_ATTR static inline void KECCAK_FN(KECCAK_WORD a[25]) {
+    KECCAK_WORD a00 = a[0], a01 = a[1], a02 = a[2], a03 = a[3], a04 = a[4];
+    KECCAK_WORD a05 = a[5], a06 = a[6], a07 = a[7], a08 = a[8], a09 = a[9];
+    KECCAK_WORD a10 = a[10], a11 = a[11], a12 = a[12], a13 = a[13], a14 = a[14];
+    KECCAK_WORD a15 = a[15], a16 = a[16], a17 = a[17], a18 = a[18], a19 = a[19];
+    KECCAK_WORD a20 = a[20], a21 = a[21], a22 = a[22], a23 = a[23], a24 = a[24];
+    KECCAK_WORD e00, e01, e02, e03, e04, e05, e06, e07, e08, e09, e10, e11, e12, e13, e14, e15, e16, e17, e18, e19, e20, e21, e22, e23, e24;
+    KECCAK_WORD c0, c1, c2, c3, c4, d0, d1, d2, d3, d4;
+    KECCAK_WORD b0, b1, b2, b3, b4;
+
+    // two rounds per iteration, ping-ponging the state between a and e
+    for (int round = 0; round < 24; round += 2) {
+        c0 = a00 ^ a05 ^ a10 ^ a15 ^ a20;
+        c1 = a01 ^ a06 ^ a11 ^ a16 ^ a21;
+        c2 = a02 ^ a07 ^ a12 ^ a17 ^ a22;
+        c3 = a03 ^ a08 ^ a13 ^ a18 ^ a23;
+        c4 = a04 ^ a09 ^ a14 ^ a19 ^ a24;
+        d0 = c4 ^ rol(c1, 1);
+        d1 = c0 ^ rol(c2, 1);
+        d2 = c1 ^ rol(c3, 1);
+        d3 = c2 ^ rol(c4, 1);
+        d4 = c3 ^ rol(c0, 1);
+        b0 = a00 ^ d0;
+        b1 = rol(a06 ^ d1, 44);
+        b2 = rol(a12 ^ d2, 43);
+        b3 = rol(a18 ^ d3, 21);
+        b4 = rol(a24 ^ d4, 14);
+        e00 = b0 ^ (~b1 & b2);
+        e01 = b1 ^ (~b2 & b3);
+        e02 = b2 ^ (~b3 & b4);
+        e03 = b3 ^ (~b4 & b0);
+        e04 = b4 ^ (~b0 & b1);
+        b0 = rol(a03 ^ d3, 28);
+        b1 = rol(a09 ^ d4, 20);
+        b2 = rol(a10 ^ d0, 3);
+        b3 = rol(a16 ^ d1, 45);
+        b4 = rol(a22 ^ d2, 61);
+        e05 = b0 ^ (~b1 & b2);
+        e06 = b1 ^ (~b2 & b3);
+        e07 = b2 ^ (~b3 & b4);
+        e08 = b3 ^ (~b4 & b0);
+        e09 = b4 ^ (~b0 & b1);
+        b0 = rol(a01 ^ d1, 1);
+        b1 = rol(a07 ^ d2, 6);
+        b2 = rol(a13 ^ d3, 25);
+        b3 = rol(a19 ^ d4, 8);
+        b4 = rol(a20 ^ d0, 18);
+        e10 = b0 ^ (~b1 & b2);
+        e11 = b1 ^ (~b2 & b3);
+        e12 = b2 ^ (~b3 & b4);
+        e13 = b3 ^ (~b4 & b0);
+        e14 = b4 ^ (~b0 & b1);
+        b0 = rol(a04 ^ d4, 27);
+        b1 = rol(a05 ^ d0, 36);
+        b2 = rol(a11 ^ d1, 10);
+        b3 = rol(a17 ^ d2, 15);
+        b4 = rol(a23 ^ d3, 56);
+        e15 = b0 ^ (~b1 & b2);
+        e16 = b1 ^ (~b2 & b3);
+        e17 = b2 ^ (~b3 & b4);
+        e18 = b3 ^ (~b4 & b0);
+        e19 = b4 ^ (~b0 & b1);
+        b0 = rol(a02 ^ d2, 62);
+        b1 = rol(a08 ^ d3, 55);
+        b2 = rol(a14 ^ d4, 39);
+        b3 = rol(a15 ^ d0, 41);
+        b4 = rol(a21 ^ d1, 2);
+        e20 = b0 ^ (~b1 & b2);
+        e21 = b1 ^ (~b2 & b3);
+        e22 = b2 ^ (~b3 & b4);
+        e23 = b3 ^ (~b4 & b0);
+        e24 = b4 ^ (~b0 & b1);
+        e00 ^= RC[round];
+        c0 = e00 ^ e05 ^ e10 ^ e15 ^ e20;
+        c1 = e01 ^ e06 ^ e11 ^ e16 ^ e21;
+        c2 = e02 ^ e07 ^ e12 ^ e17 ^ e22;
+        c3 = e03 ^ e08 ^ e13 ^ e18 ^ e23;
+        c4 = e04 ^ e09 ^ e14 ^ e19 ^ e24;
+        d0 = c4 ^ rol(c1, 1);
+        d1 = c0 ^ rol(c2, 1);
+        d2 = c1 ^ rol(c3, 1);
+        d3 = c2 ^ rol(c4, 1);
+        d4 = c3 ^ rol(c0, 1);
+        b0 = e00 ^ d0;
+        b1 = rol(e06 ^ d1, 44);
+        b2 = rol(e12 ^ d2, 43);
+        b3 = rol(e18 ^ d3, 21);
+        b4 = rol(e24 ^ d4, 14);
+        a00 = b0 ^ (~b1 & b2);
+        a01 = b1 ^ (~b2 & b3);
+        a02 = b2 ^ (~b3 & b4);
+        a03 = b3 ^ (~b4 & b0);
+        a04 = b4 ^ (~b0 & b1);
+        b0 = rol(e03 ^ d3, 28);
+        b1 = rol(e09 ^ d4, 20);
+        b2 = rol(e10 ^ d0, 3);
+        b3 = rol(e16 ^ d1, 45);
+        b4 = rol(e22 ^ d2, 61);
+        a05 = b0 ^ (~b1 & b2);
+        a06 = b1 ^ (~b2 & b3);
+        a07 = b2 ^ (~b3 & b4);
+        a08 = b3 ^ (~b4 & b0);
+        a09 = b4 ^ (~b0 & b1);
+        b0 = rol(e01 ^ d1, 1);
+        b1 = rol(e07 ^ d2, 6);
+        b2 = rol(e13 ^ d3, 25);
+        b3 = rol(e19 ^ d4, 8);
+        b4 = rol(e20 ^ d0, 18);
+        a10 = b0 ^ (~b1 & b2);
+        a11 = b1 ^ (~b2 & b3);
+        a12 = b2 ^ (~b3 & b4);
+        a13 = b3 ^ (~b4 & b0);
+        a14 = b4 ^ (~b0 & b1);
+        b0 = rol(e04 ^ d4, 27);
+        b1 = rol(e05 ^ d0, 36);
+        b2 = rol(e11 ^ d1, 10);
+        b3 = rol(e17 ^ d2, 15);
+        b4 = rol(e23 ^ d3, 56);
+        a15 = b0 ^ (~b1 & b2);
+        a16 = b1 ^ (~b2 & b3);
+        a17 = b2 ^ (~b3 & b4);
+        a18 = b3 ^ (~b4 & b0);
+        a19 = b4 ^ (~b0 & b1);
+        b0 = rol(e02 ^ d2, 62);
+        b1 = rol(e08 ^ d3, 55);
+        b2 = rol(e14 ^ d4, 39);
+        b3 = rol(e15 ^ d0, 41);
+        b4 = rol(e21 ^ d1, 2);
+        a20 = b0 ^ (~b1 & b2);
+        a21 = b1 ^ (~b2 & b3);
+        a22 = b2 ^ (~b3 & b4);
+        a23 = b3 ^ (~b4 & b0);
+        a24 = b4 ^ (~b0 & b1);
+        a00 ^= RC[round + 1];
+    }
+
+    a[0] = a00; a[1] = a01; a[2] = a02; a[3] = a03; a[4] = a04;
+    a[5] = a05; a[6] = a06; a[7] = a07; a[8] = a08; a[9] = a09;
+    a[10] = a10; a[11] = a11; a[12] = a12; a[13] = a13; a[14] = a14;
+    a[15] = a15; a[16] = a16; a[17] = a17; a[18] = a18; a[19] = a19;
+    a[20] = a20; a[21] = a21; a[22] = a22; a[23] = a23; a[24] = a24;
+}
+
+#undef KECCAK_WORD
+#undef KECCAK_FN
+#undef KECCAK_ATTR
@@ -0,0 +1,345 @@
+/*
+  This file is part of ethash.
+
+  ethash is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  ethash is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with ethash.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file selftest.c
+* @date 2026
+*
+* Known answers for Keccak, seed hashes and epoch sizes, the published
+* epoch 0 hash, and every hashing path, ethash_quick_hash included, held
+* bit-exact to ethash_hash on a dataset small enough to build in a few
+* milliseconds. bench --selftest runs it on its own, together with known
+* verdicts for a batch of shares from two epochs, light and from a DAG.
+*/
+
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ethash.h"
+#include "verify.h"
+
+// from the sha3 section of ethash.c
+int sha3_256(uint8_t *, size_t, const uint8_t *, size_t);
+int sha3_512(uint8_t *, size_t, const uint8_t *, size_t);
+
+// 16 cache nodes and 256 pages: every path below visits most of the DAG
+#define TINY_CACHE_SIZE 1024
+#define TINY_FULL_SIZE (32 * 1024)
+
+// more than any SIMD width, and not a multiple of one, so tails are covered
+#define TINY_NONCES 37
+
+static const char KECCAK_256_EMPTY[] = "c5d2460186f7233c927e7db2dcc703c0e500b653ca82273b7bfad8045d85a470";
+static const char KECCAK_512_EMPTY[] =
+        "0eab42de4c3ceb9235fc91acffe746b29c29a8c366b7c60e4e67c466f36a4304"
+        "c00fa9caf9d87976ba469bcbe06713b435f091ef2769fb160cdab33d3670680e";
+
+// seed of epoch 1 is keccak256 of 32 zero bytes
+static const char SEED_EPOCH_1[] = "290decd9548b62a8d60345a988386fc84ba6bc95484008f6362f93160ef3e563";
+
+// block 22 of the main chain, epoch 0
+static const char BLOCK_22_HEADER[] = "372eca2454ead349c3df0ab5d00b0b706b23e49d469387db91811cee0358fc6d";
+static const uint64_t BLOCK_22_NONCE = 0x495732e0ed7a801cULL;
+static const char BLOCK_22_MIX[] = "2f74cdeb198af0b9abe65d22d372e22fb2d474371774a9583c1cc427a07939f5";
+static const char BLOCK_22_RESULT[] = "00000b184f1fdd88bfd94c86c39e65db0c36144d5e43f745f722196e730cb614";
+
+// the same header and nonce in epoch 1
+static const uint32_t EPOCH_1_BLOCK = 30000;
+static const char EPOCH_1_MIX[] = "122fb258f2b7080c3b57a5065296f73c90a911d57cd16fb0cc8847989f6217a2";
+
+static void from_hex(uint8_t *out, char const *hex, size_t size) {
+    for (size_t i = 0; i != size; ++i) {
+        unsigned byte;
+        sscanf(hex + 2 * i, "%2x", &byte);
+        out[i] = (uint8_t) byte;
+    }
+}
+
+static int equals_hex(uint8_t const *bytes, char const *hex, size_t size) {
+    uint8_t expect[64];
+    from_hex(expect, hex, size);
+    return memcmp(bytes, expect, size) == 0;
+}
+
+static int same_value(ethash_return_value const *a, ethash_return_value const *b) {
+    return memcmp(a->mix_hash, b->mix_hash, 32) == 0 && memcmp(a->result, b->result, 32) == 0;
+}
+
+static int fail(char *err, size_t err_len, char const *format, ...) {
+    if (err && err_len) {
+        va_list args;
+        va_start(args, format);
+        vsnprintf(err, err_len, format, args);
+        va_end(args);
+    }
+    return -1;
+}
+
+// ethash_hash is the reference; every other path must reproduce it.
+static int check_tiny(char *err, size_t err_len) {
+    ethash_params params;
+    params.cache_size = TINY_CACHE_SIZE;
+    params.full_size = TINY_FULL_SIZE;
+    uint8_t seed[32];
+    ethash_get_seedhash(seed, ETHASH_EPOCH_LENGTH);
+
+    ethash_cache cache;
+    cache.mem = malloc(params.cache_size);
+    void *full = malloc(params.full_size);
+    ethash_item_lru *lru = ethash_item_lru_new(64);
+    ethash_partial_dag *partial = NULL;
+    ethash_return_value *expect = malloc(3 * TINY_NONCES * sizeof(ethash_return_value));
+    int rc = -1;
+    if (!cache.mem || !full || !lru || !expect) {
+        rc = fail(err, err_len, "out of memory");
+        goto done;
+    }
+    ethash_mkcache(&cache, &params, seed);
+    ethash_compute_full_data(full, &params, &cache);
+    partial = ethash_partial_dag_new(&params, &cache, 0.5, 64);
+    if (!partial) {
+        rc = fail(err, err_len, "out of memory");
+        goto done;
+    }
+
+    uint8_t header[32];
+    from_hex(header, BLOCK_22_HEADER, 32);
+    uint64_t nonces[TINY_NONCES];
+    for (unsigned i = 0; i != TINY_NONCES; ++i) {
+        nonces[i] = BLOCK_22_NONCE + i;
+        ethash_hash(&expect[i], (node const *) full, &params, header, nonces[i]);
+    }
+
+    ethash_return_value *interleaved = expect + TINY_NONCES;
+    ethash_return_value *batch = expect + 2 * TINY_NONCES;
+    ethash_hash_interleaved(interleaved, (node const *) full, &params, header, nonces, TINY_NONCES);
+    ethash_hash_batch(batch, (node const *) full, &params, header, nonces, TINY_NONCES);
+    for (unsigned i = 0; i != TINY_NONCES; ++i) {
+        if (!same_value(&interleaved[i], &expect[i])) {
+            rc = fail(err, err_len, "ethash_hash_interleaved differs from ethash_hash at nonce %u", i);
+            goto done;
+        }
+        if (!same_value(&batch[i], &expect[i])) {
+            rc = fail(err, err_len, "ethash_hash_batch (%u lanes) differs from ethash_hash at nonce %u",
+                    ethash_hash_batch_lanes(), i);
+            goto done;
+        }
+        // twice with the LRU: once filling it, once served from it
+        for (int pass = 0; pass != 3; ++pass) {
+            ethash_return_value light;
+            ethash_light_compute(&light, &cache, pass ? lru : NULL, &params, header, nonces[i]);
+            if (!same_value(&light, &expect[i])) {
+                rc = fail(err, err_len, "ethash_light_compute%s differs from ethash_hash at nonce %u",
+                        pass ? " with LRU" : "", i);
+                goto done;
+            }
+        }
+        ethash_return_value part;
+        ethash_partial_hash(&part, partial, header, nonces[i]);
+        if (!same_value(&part, &expect[i])) {
+            rc = fail(err, err_len, "ethash_partial_hash differs from ethash_hash at nonce %u", i);
+            goto done;
+        }
+        // the quick hash takes the claimed mix on trust: right with the real
+        // one, and a wrong one must change the result
+        uint8_t quick[32];
+        ethash_quick_hash(quick, header, nonces[i], expect[i].mix_hash);
+        if (memcmp(quick, expect[i].result, 32) != 0) {
+            rc = fail(err, err_len, "ethash_quick_hash differs from ethash_hash at nonce %u", i);
+            goto done;
+        }
+        uint8_t wrong_mix[32];
+        memcpy(wrong_mix, expect[i].mix_hash, 32);
+        wrong_mix[i % 32] ^= 1;
+        ethash_quick_hash(quick, header, nonces[i], wrong_mix);
+        if (memcmp(quick, expect[i].result, 32) == 0) {
+            rc = fail(err, err_len, "ethash_quick_hash ignores the mix at nonce %u", i);
+            goto done;
+        }
+    }
+
+    // every nonce meets an all-ones boundary; hits come back in nonce order
+    uint8_t boundary[32];
+    memset(boundary, 0xff, sizeof(boundary));
+    ethash_solution solutions[8];
+    unsigned hits = ethash_search(solutions, 8, (node const *) full, &params, header, nonces[0], TINY_NONCES, boundary);
+    if (hits != TINY_NONCES) {
+        rc = fail(err, err_len, "ethash_search found %u of %u nonces", hits, TINY_NONCES);
+        goto done;
+    }
+    for (unsigned i = 0; i != 8; ++i) {
+        if (solutions[i].nonce != nonces[i] || !same_value(&solutions[i].value, &expect[i])) {
+            rc = fail(err, err_len, "ethash_search solution %u differs from ethash_hash", i);
+            goto done;
+        }
+    }
+    rc = 0;
+
+done:
+    free(expect);
+    ethash_partial_dag_delete(partial);
+    if (lru) {
+        ethash_item_lru_delete(lru);
+    }
+    free(full);
+    free(cache.mem);
+    return rc;
+}
+
+// Builds the 16MB epoch 0 cache, so takes about a second.
+static int check_block_22(char *err, size_t err_len) {
+    ethash_params const params = ethash_get_params(22);
+    uint8_t seed[32];
+    ethash_get_seedhash(seed, 22);
+    ethash_cache cache;
+    cache.mem = malloc(params.cache_size);
+    if (!cache.mem) {
+        return fail(err, err_len, "out of memory");
+    }
+    ethash_mkcache(&cache, &params, seed);
+
+    uint8_t header[32];
+    from_hex(header, BLOCK_22_HEADER, 32);
+    ethash_return_value value;
+    ethash_light_compute(&value, &cache, NULL, &params, header, BLOCK_22_NONCE);
+    free(cache.mem);
+    if (!equals_hex(value.mix_hash, BLOCK_22_MIX, 32) || !equals_hex(value.result, BLOCK_22_RESULT, 32)) {
+        return fail(err, err_len, "block 22 mix or result differs from the published value");
+    }
+    return 0;
+}
+
+// block 22's header; the boundary is zero_bytes of 0x00, then all 0xff
+static void make_share(ethash_share *share, uint32_t block_number, uint64_t nonce, char const *mix, size_t zero_bytes) {
+    from_hex(share->header_hash, BLOCK_22_HEADER, 32);
+    share->nonce = nonce;
+    from_hex(share->mix_hash, mix, 32);
+    share->block_number = block_number;
+    memset(share->boundary, 0xff, 32);
+    memset(share->boundary, 0, zero_bytes);
+}
+
+static int check_verdicts(ethash_verifier *verifier, ethash_share const *shares, ethash_share_rc const *expect,
+        size_t count, char const *pass, char *err, size_t err_len) {
+    ethash_share_rc results[8];
+    size_t valid = 0;
+    for (size_t i = 0; i != count; ++i) {
+        valid += expect[i] == ETHASH_SHARE_VALID;
+    }
+    size_t const got = ethash_verify_shares(verifier, shares, count, results);
+    for (size_t i = 0; i != count; ++i) {
+        if (results[i] != expect[i]) {
+            return fail(err, err_len, "%s: share %zu verified as %d, expected %d", pass, i, results[i], expect[i]);
+        }
+    }
+    if (got != valid) {
+        return fail(err, err_len, "%s: %zu shares counted valid, expected %zu", pass, got, valid);
+    }
+    return 0;
+}
+
+int ethash_verify_self_test(char *err, size_t err_len) {
+    ethash_params const params = ethash_get_params(0);
+    ethash_verifier *verifier = ethash_verifier_new(2, 2);
+    // an all-zero epoch 0 DAG: calloc'd pages cost nothing until touched, and
+    // it gives mixes the cache never would, so its verdicts show which path ran
+    void *zero_full = calloc(1, params.full_size);
+    int rc = -1;
+    if (!verifier || !zero_full) {
+        rc = fail(err, err_len, "out of memory");
+        goto done;
+    }
+
+    // block 22's result starts 00000b: under two zero bytes, over three
+    ethash_share shares[8];
+    make_share(&shares[0], 22, BLOCK_22_NONCE, BLOCK_22_MIX, 2);
+    make_share(&shares[1], EPOCH_1_BLOCK, BLOCK_22_NONCE, EPOCH_1_MIX, 0);
+    make_share(&shares[2], 22, BLOCK_22_NONCE, BLOCK_22_MIX, 3);
+    make_share(&shares[3], EPOCH_1_BLOCK, BLOCK_22_NONCE, EPOCH_1_MIX, 0);
+    shares[3].mix_hash[31] ^= 1;
+    make_share(&shares[4], EPOCH_1_BLOCK, BLOCK_22_NONCE, BLOCK_22_MIX, 0);
+    make_share(&shares[5], 22, BLOCK_22_NONCE, EPOCH_1_MIX, 0);
+    make_share(&shares[6], 22, BLOCK_22_NONCE + 1, BLOCK_22_MIX, 0);
+    static const ethash_share_rc mixed[7] = {
+        ETHASH_SHARE_VALID,
+        ETHASH_SHARE_VALID,
+        ETHASH_SHARE_ABOVE_BOUNDARY,        // real mix, boundary below its result
+        ETHASH_SHARE_BAD_MIX,               // one bit off
+        ETHASH_SHARE_BAD_MIX,               // epoch 0's mix claimed in epoch 1
+        ETHASH_SHARE_BAD_MIX,               // and the other way round
+        ETHASH_SHARE_BAD_MIX                // another nonce's mix
+    };
+    if (check_verdicts(verifier, shares, mixed, 7, "light", err, err_len) != 0) {
+        goto done;
+    }
+
+    ethash_return_value zero;
+    uint8_t header[32];
+    from_hex(header, BLOCK_22_HEADER, 32);
+    ethash_hash(&zero, (node const *) zero_full, &params, header, BLOCK_22_NONCE);
+    shares[2] = shares[0];
+    memcpy(shares[2].mix_hash, zero.mix_hash, 32);
+    memset(shares[2].boundary, 0xff, 32);
+    static const ethash_share_rc with_full[3] = {
+        ETHASH_SHARE_BAD_MIX,               // right for the real DAG only
+        ETHASH_SHARE_VALID,                 // epoch 1 still from its cache
+        ETHASH_SHARE_VALID                  // right for the zero DAG only
+    };
+    static const ethash_share_rc without_full[3] = {
+        ETHASH_SHARE_VALID,
+        ETHASH_SHARE_VALID,
+        ETHASH_SHARE_BAD_MIX
+    };
+    ethash_verifier_set_full(verifier, 0, (node const *) zero_full);
+    if (check_verdicts(verifier, shares, with_full, 3, "full", err, err_len) != 0) {
+        goto done;
+    }
+    ethash_verifier_set_full(verifier, 0, NULL);
+    rc = check_verdicts(verifier, shares, without_full, 3, "back to light", err, err_len);
+
+done:
+    ethash_verifier_delete(verifier);
+    free(zero_full);
+    return rc;
+}
+
+int ethash_self_test(int published, char *err, size_t err_len) {
+    uint8_t out[64];
+    sha3_256(out, 32, NULL, 0);
+    if (!equals_hex(out, KECCAK_256_EMPTY, 32)) {
+        return fail(err, err_len, "keccak256 of the empty string is wrong");
+    }
+    sha3_512(out, 64, NULL, 0);
+    if (!equals_hex(out, KECCAK_512_EMPTY, 64)) {
+        return fail(err, err_len, "keccak512 of the empty string is wrong");
+    }
+
+    uint8_t seed[32];
+    ethash_get_seedhash(seed, ETHASH_EPOCH_LENGTH);
+    if (!equals_hex(seed, SEED_EPOCH_1, 32)) {
+        return fail(err, err_len, "seed hash of epoch 1 is wrong");
+    }
+    ethash_params const params = ethash_get_params(0);
+    if (params.full_size != 1073739904U || params.cache_size != 16776896U) {
+        return fail(err, err_len, "epoch 0 sizes are %zu/%zu, expected 1073739904/16776896",
+                (size_t) params.full_size, (size_t) params.cache_size);
+    }
+
+    if (check_tiny(err, err_len) != 0) {
+        return -1;
+    }
+    return published ? check_block_22(err, err_len) : 0;
+}
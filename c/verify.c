@@ -0,0 +1,329 @@
+/*
+  This file is part of ethash.
+
+  ethash is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  ethash is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with ethash.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file verify.c
+* @date 2026
+*/
+
+#include <pthread.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include "verify.h"
+
+// shares a thread claims at a time; light verifications take about a
+// millisecond each, so this keeps the lock cold without starving the tail
+#define VERIFY_CHUNK 16
+
+// dataset items memoized per epoch for the light path
+#define VERIFY_LRU_ITEMS (1U << 14)
+
+#define NO_EPOCH UINT32_MAX
+
+typedef struct verify_epoch {
+    uint32_t epoch;                 // NO_EPOCH for a free slot
+    ethash_params params;
+    ethash_cache cache;             // mem NULL until the light path needs it
+    ethash_item_lru *lru;
+    node const *full;               // attached DAG, NULL for the light path
+    uint64_t last_used;
+} verify_epoch;
+
+typedef struct verify_task {
+    uint32_t epoch;
+    size_t index;                   // into shares and results
+    ethash_share const *share;
+} verify_task;
+
+struct ethash_verifier {
+    pthread_mutex_t call_lock;      // one batch at a time
+    pthread_mutex_t lock;           // the dispatch below
+    pthread_cond_t work_ready;
+    pthread_cond_t work_done;
+    bool stop;
+    verify_task const *tasks;
+    size_t num_tasks;
+    size_t next_task;
+    unsigned busy;                  // threads inside a chunk
+    verify_epoch const *epoch;      // of every task dispatched
+    ethash_share_rc *results;
+
+    pthread_t *threads;
+    unsigned num_threads;           // helpers, besides the calling thread
+    verify_epoch *epochs;
+    unsigned max_epochs;
+    uint64_t clock;
+};
+
+static void verify_chunk(verify_epoch const *epoch, verify_task const *tasks, size_t count, ethash_share_rc *results) {
+    for (size_t t = 0; t != count; ++t) {
+        ethash_share const *share = tasks[t].share;
+        ethash_return_value value;
+        if (epoch->full) {
+            ethash_hash(&value, epoch->full, &epoch->params, share->header_hash, share->nonce);
+        } else {
+            ethash_light_compute(&value, &epoch->cache, epoch->lru, &epoch->params, share->header_hash, share->nonce);
+        }
+        // the quick check already put the result from this mix under the boundary
+        results[tasks[t].index] = memcmp(value.mix_hash, share->mix_hash, 32) == 0
+                ? ETHASH_SHARE_VALID : ETHASH_SHARE_BAD_MIX;
+    }
+}
+
+// Claims chunks until the dispatched tasks are all taken; lock held on entry
+// and exit.
+static void verify_run(ethash_verifier *verifier) {
+    while (verifier->next_task < verifier->num_tasks) {
+        size_t const first = verifier->next_task;
+        size_t const count = verifier->num_tasks - first < VERIFY_CHUNK ? verifier->num_tasks - first : VERIFY_CHUNK;
+        verifier->next_task = first + count;
+        verifier->busy++;
+        verify_epoch const *epoch = verifier->epoch;
+        verify_task const *tasks = verifier->tasks + first;
+        ethash_share_rc *results = verifier->results;
+        pthread_mutex_unlock(&verifier->lock);
+
+        verify_chunk(epoch, tasks, count, results);
+
+        pthread_mutex_lock(&verifier->lock);
+        if (--verifier->busy == 0 && verifier->next_task == verifier->num_tasks) {
+            pthread_cond_broadcast(&verifier->work_done);
+        }
+    }
+}
+
+static void *verify_worker(void *arg) {
+    ethash_verifier *verifier = (ethash_verifier *) arg;
+    pthread_mutex_lock(&verifier->lock);
+    for (;;) {
+        while (!verifier->stop && verifier->next_task >= verifier->num_tasks) {
+            pthread_cond_wait(&verifier->work_ready, &verifier->lock);
+        }
+        if (verifier->stop) {
+            break;
+        }
+        verify_run(verifier);
+    }
+    pthread_mutex_unlock(&verifier->lock);
+    return NULL;
+}
+
+// Runs tasks on the helpers and the calling thread; returns when all are done.
+static void verify_dispatch(ethash_verifier *verifier, verify_epoch const *epoch, verify_task const *tasks, size_t count, ethash_share_rc *results) {
+    pthread_mutex_lock(&verifier->lock);
+    verifier->tasks = tasks;
+    verifier->num_tasks = count;
+    verifier->next_task = 0;
+    verifier->epoch = epoch;
+    verifier->results = results;
+    pthread_cond_broadcast(&verifier->work_ready);
+    verify_run(verifier);
+    while (verifier->busy) {
+        pthread_cond_wait(&verifier->work_done, &verifier->lock);
+    }
+    verifier->tasks = NULL;
+    verifier->num_tasks = verifier->next_task = 0;
+    pthread_mutex_unlock(&verifier->lock);
+}
+
+static void epoch_release(verify_epoch *slot) {
+    free(slot->cache.mem);
+    slot->cache.mem = NULL;
+    if (slot->lru) {
+        // a later cache may be allocated at the same address
+        ethash_item_lru_clear(slot->lru);
+    }
+    slot->full = NULL;
+    slot->epoch = NO_EPOCH;
+}
+
+// The epoch's slot, taking over the least recently used one if it has none.
+static verify_epoch *epoch_slot(ethash_verifier *verifier, uint32_t epoch) {
+    verify_epoch *victim = NULL;
+    for (unsigned i = 0; i != verifier->max_epochs; ++i) {
+        verify_epoch *slot = &verifier->epochs[i];
+        if (slot->epoch == epoch) {
+            slot->last_used = ++verifier->clock;
+            return slot;
+        }
+        if (slot->epoch == NO_EPOCH) {
+            if (!victim || victim->epoch != NO_EPOCH) {
+                victim = slot;
+            }
+        } else if (!victim || (victim->epoch != NO_EPOCH && slot->last_used < victim->last_used)) {
+            victim = slot;
+        }
+    }
+    epoch_release(victim);
+    victim->epoch = epoch;
+    victim->params = ethash_get_params(epoch * ETHASH_EPOCH_LENGTH);
+    victim->last_used = ++verifier->clock;
+    return victim;
+}
+
+static int epoch_prepare(verify_epoch *slot) {
+    if (slot->full || slot->cache.mem) {
+        return 0;
+    }
+    slot->cache.mem = malloc(slot->params.cache_size);
+    if (!slot->cache.mem) {
+        return -1;
+    }
+    uint8_t seed[32];
+    ethash_get_seedhash(seed, slot->epoch * ETHASH_EPOCH_LENGTH);
+    ethash_mkcache(&slot->cache, &slot->params, seed);
+    return 0;
+}
+
+ethash_verifier *ethash_verifier_new(unsigned threads, unsigned max_epochs) {
+    if (!threads) {
+        long online = sysconf(_SC_NPROCESSORS_ONLN);
+        threads = online > 0 ? (unsigned) online : 1;
+    }
+    if (!max_epochs) {
+        max_epochs = 1;
+    }
+    ethash_verifier *verifier = (ethash_verifier *) calloc(1, sizeof(ethash_verifier));
+    if (!verifier) {
+        return NULL;
+    }
+    verifier->epochs = (verify_epoch *) calloc(max_epochs, sizeof(verify_epoch));
+    verifier->threads = (pthread_t *) calloc(threads, sizeof(pthread_t));
+    if (!verifier->epochs || !verifier->threads) {
+        free(verifier->epochs);
+        free(verifier->threads);
+        free(verifier);
+        return NULL;
+    }
+    verifier->max_epochs = max_epochs;
+    for (unsigned i = 0; i != max_epochs; ++i) {
+        verifier->epochs[i].epoch = NO_EPOCH;
+        verifier->epochs[i].lru = ethash_item_lru_new(VERIFY_LRU_ITEMS);
+    }
+    pthread_mutex_init(&verifier->call_lock, NULL);
+    pthread_mutex_init(&verifier->lock, NULL);
+    pthread_cond_init(&verifier->work_ready, NULL);
+    pthread_cond_init(&verifier->work_done, NULL);
+    // fewer helpers if the system will not give us more
+    for (unsigned i = 0; i + 1 < threads; ++i) {
+        if (pthread_create(&verifier->threads[verifier->num_threads], NULL, verify_worker, verifier) == 0) {
+            verifier->num_threads++;
+        }
+    }
+    return verifier;
+}
+
+void ethash_verifier_delete(ethash_verifier *verifier) {
+    if (!verifier) {
+        return;
+    }
+    pthread_mutex_lock(&verifier->lock);
+    verifier->stop = true;
+    pthread_cond_broadcast(&verifier->work_ready);
+    pthread_mutex_unlock(&verifier->lock);
+    for (unsigned i = 0; i != verifier->num_threads; ++i) {
+        pthread_join(verifier->threads[i], NULL);
+    }
+    for (unsigned i = 0; i != verifier->max_epochs; ++i) {
+        epoch_release(&verifier->epochs[i]);
+        ethash_item_lru_delete(verifier->epochs[i].lru);
+    }
+    pthread_cond_destroy(&verifier->work_ready);
+    pthread_cond_destroy(&verifier->work_done);
+    pthread_mutex_destroy(&verifier->lock);
+    pthread_mutex_destroy(&verifier->call_lock);
+    free(verifier->threads);
+    free(verifier->epochs);
+    free(verifier);
+}
+
+void ethash_verifier_set_full(ethash_verifier *verifier, uint32_t epoch, node const *full_nodes) {
+    pthread_mutex_lock(&verifier->call_lock);
+    verify_epoch *slot = epoch_slot(verifier, epoch);
+    slot->full = full_nodes;
+    pthread_mutex_unlock(&verifier->call_lock);
+}
+
+static int compare_tasks(void const *a, void const *b) {
+    verify_task const *x = (verify_task const *) a, *y = (verify_task const *) b;
+    if (x->epoch != y->epoch) {
+        return x->epoch < y->epoch ? -1 : 1;
+    }
+    int const header = memcmp(x->share->header_hash, y->share->header_hash, 32);
+    if (header) {
+        return header;
+    }
+    return (x->index > y->index) - (x->index < y->index);
+}
+
+size_t ethash_verify_shares(
+        ethash_verifier *verifier,
+        ethash_share const *shares,
+        size_t count,
+        ethash_share_rc *results) {
+    verify_task *tasks = (verify_task *) malloc(count * sizeof(verify_task) + 1);
+    if (!tasks) {
+        for (size_t i = 0; i != count; ++i) {
+            results[i] = ETHASH_SHARE_ERROR;
+        }
+        return 0;
+    }
+
+    // cheap rejects first; only the survivors touch a cache or DAG
+    size_t pending = 0;
+    for (size_t i = 0; i != count; ++i) {
+        uint8_t result[32];
+        ethash_quick_hash(result, shares[i].header_hash, shares[i].nonce, shares[i].mix_hash);
+        if (!ethash_check_difficulty(result, shares[i].boundary)) {
+            results[i] = ETHASH_SHARE_ABOVE_BOUNDARY;
+            continue;
+        }
+        tasks[pending].epoch = shares[i].block_number / ETHASH_EPOCH_LENGTH;
+        tasks[pending].index = i;
+        tasks[pending].share = &shares[i];
+        ++pending;
+    }
+    qsort(tasks, pending, sizeof(verify_task), compare_tasks);
+
+    // one epoch at a time, so each cache is built at most once per batch and
+    // only max_epochs are ever held
+    pthread_mutex_lock(&verifier->call_lock);
+    for (size_t first = 0; first != pending;) {
+        size_t last = first;
+        while (last != pending && tasks[last].epoch == tasks[first].epoch) {
+            ++last;
+        }
+        verify_epoch *slot = epoch_slot(verifier, tasks[first].epoch);
+        if (epoch_prepare(slot) == 0) {
+            verify_dispatch(verifier, slot, tasks + first, last - first, results);
+        } else {
+            epoch_release(slot);
+            for (size_t t = first; t != last; ++t) {
+                results[tasks[t].index] = ETHASH_SHARE_ERROR;
+            }
+        }
+        first = last;
+    }
+    pthread_mutex_unlock(&verifier->call_lock);
+    free(tasks);
+
+    size_t valid = 0;
+    for (size_t i = 0; i != count; ++i) {
+        valid += results[i] == ETHASH_SHARE_VALID;
+    }
+    return valid;
+}
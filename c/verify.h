@@ -0,0 +1,79 @@
+/*
+  This file is part of ethash.
+
+  ethash is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  ethash is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with ethash.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file verify.h
+* @date 2026
+*
+* Batch verification of submitted shares, as a pool does it. Every share is
+* first checked with ethash_quick_hash against its boundary, which rejects
+* garbage for two Keccaks. Survivors are grouped by epoch and header and
+* recomputed on a pool of threads: from the epoch's DAG when one has been
+* attached, otherwise through the light path from a cache kept per epoch.
+*/
+#pragma once
+
+#include <stdint.h>
+#include <stddef.h>
+#include "ethash.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef struct ethash_share {
+    uint8_t header_hash[32];
+    uint64_t nonce;
+    uint8_t mix_hash[32];           // as claimed by the miner
+    uint8_t boundary[32];
+    uint32_t block_number;
+} ethash_share;
+
+typedef enum ethash_share_rc {
+    ETHASH_SHARE_VALID = 0,
+    ETHASH_SHARE_ABOVE_BOUNDARY,    // fails the quick check, whatever the DAG says
+    ETHASH_SHARE_BAD_MIX,           // claimed mix is not the one the DAG gives
+    ETHASH_SHARE_ERROR              // no memory for the epoch's cache
+} ethash_share_rc;
+
+typedef struct ethash_verifier ethash_verifier;
+
+// threads 0 means one per online CPU, counting the calling thread; at most
+// max_epochs caches are kept, least recently used dropped first.
+ethash_verifier *ethash_verifier_new(unsigned threads, unsigned max_epochs);
+void ethash_verifier_delete(ethash_verifier *verifier);
+
+// Verifies the epoch's shares against full_nodes instead of the cache, which
+// is much faster; NULL goes back to the cache. full_nodes must stay valid
+// until replaced, and is forgotten if the epoch falls out of the max_epochs
+// most recently used.
+void ethash_verifier_set_full(ethash_verifier *verifier, uint32_t epoch, node const *full_nodes);
+
+// results[i] for shares[i]; returns the number of valid shares. Concurrent
+// calls are run one after another.
+size_t ethash_verify_shares(
+        ethash_verifier *verifier,
+        ethash_share const *shares,
+        size_t count,
+        ethash_share_rc *results);
+
+// Valid and invalid shares of epochs 0 and 1 checked for their expected
+// verdicts, from the caches and with a DAG set for epoch 0; a few seconds.
+// Returns 0, or -1 with the first failure described in err. (selftest.c)
+int ethash_verify_self_test(char *err, size_t err_len);
+
+#ifdef __cplusplus
+}
+#endif
@@ -0,0 +1,186 @@
+/*
+  This file is part of ethash.
+
+  ethash is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  ethash is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with ethash.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file backend.h
+* @date 2026
+*
+* What the miner driver needs from a device: load an epoch's DAG, take
+* asynchronous search batches, hand back their results in submission order.
+* Implemented for the OpenCL/XRT path (backend_ocl.cpp) and for CPU threads
+* over c/ethash.c (backend_cpu.cpp), so the same driver runs, and can be
+* compared, on hosts with or without an accelerator.
+*/
+#pragma once
+
+#include <stdint.h>
+#include <string.h>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "../c/ethash.h"
+
+// solutions kept per batch, the first found, as the kernel keeps them
+#define BATCH_SOLUTIONS 8
+
+// What the device should be hashing. generation increments with every new
+// header so results from batches queued with older work can be told apart.
+struct work_package
+{
+    uint8_t header[32];
+    uint8_t boundary[32];
+    uint32_t epoch;                 // of the block the header is for
+    uint64_t generation;
+    std::chrono::steady_clock::time_point received;   // when the host got it
+};
+
+// Latest work, replaced from a feeder thread while the miner loop keeps
+// batches in flight; the loop picks it up on the next submit.
+class work_feed
+{
+public:
+    explicit work_feed(const work_package& initial) : current_(initial) {}
+
+    // boundary and epoch may be NULL to keep the current ones; returns the
+    // new generation
+    uint64_t update(const uint8_t header[32], const uint8_t* boundary, const uint32_t* epoch,
+            std::chrono::steady_clock::time_point received)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        memcpy(current_.header, header, 32);
+        if (boundary)
+            memcpy(current_.boundary, boundary, 32);
+        if (epoch)
+            current_.epoch = *epoch;
+        current_.received = received;
+        return ++current_.generation;
+    }
+
+    work_package get() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return current_;
+    }
+
+private:
+    mutable std::mutex mutex_;
+    work_package current_;
+};
+
+// unit in which a DAG is produced and uploaded
+static const size_t DAG_CHUNK_BYTES = 32 << 20;
+
+// A DAG still being read in or generated, chunk by chunk from the start, so
+// a backend can upload what is final while the rest is produced.
+class dag_progress
+{
+public:
+    virtual ~dag_progress() {}
+
+    // Blocks until the first end bytes are final; false with a reason when the
+    // DAG could not be produced.
+    virtual bool wait(size_t end, std::string& error) const = 0;
+};
+
+// The DAG of one epoch, resident in host memory (page-aligned) and shared by
+// all backends.
+struct epoch_context
+{
+    uint32_t epoch;
+    ethash_params params;
+    void const* dag;
+    const dag_progress* progress;   // NULL when the whole DAG is final
+};
+
+// count nonces: start_nonce, start_nonce + stride, ...
+struct search_request
+{
+    work_package work;
+    uint64_t start_nonce;
+    uint32_t stride;
+    uint32_t count;
+};
+
+struct search_result
+{
+    search_request request;
+    uint32_t hashed;                          // request.count, less when cancelled
+    uint32_t hits;                            // total, may exceed solutions.size()
+    std::vector<ethash_solution> solutions;   // at most BATCH_SOLUTIONS
+    std::chrono::steady_clock::time_point started;    // first hash of the batch
+    double seconds;                           // submit to completion
+    double device_seconds;                    // spent hashing; 0 when unknown
+    double transfer_seconds;                  // spent copying to and from the device
+};
+
+class miner_backend
+{
+public:
+    virtual ~miner_backend() {}
+
+    virtual std::string name() const = 0;
+
+    // Finds and opens the device. On failure returns false with a reason.
+    virtual bool init(std::string& error) = 0;
+
+    // Makes ctx the DAG for following batches; only with nothing in flight.
+    // ctx.dag must stay mapped until the next load_epoch or destruction.
+    // Returns once the whole DAG is final and on the device.
+    virtual bool load_epoch(const epoch_context& ctx, std::string& error) = 0;
+
+    // Batches that can be queued at once without blocking submit.
+    virtual unsigned max_in_flight() const = 0;
+
+    // Kernel instances or threads working on batches in parallel.
+    virtual unsigned compute_units() const = 0;
+
+    // Queues a batch; requires fewer than max_in_flight() outstanding.
+    virtual void submit(const search_request& request) = 0;
+
+    // Takes the oldest outstanding batch if it has completed, waiting for it
+    // when wait is set. Returns false when there is nothing to return.
+    virtual bool poll(search_result& result, bool wait) = 0;
+
+    // Abandons the unhashed part of outstanding and later submitted batches
+    // for generations below generation, so new work is not queued behind
+    // stale batches. They still come back from poll, in order, with what was
+    // hashed. Safe to call from any thread; a no-op where a batch, once
+    // queued, cannot be cut short.
+    virtual void cancel(uint64_t generation) { (void) generation; }
+
+    // Hashes completed by each worker thread so far, for backends that have
+    // them.
+    virtual std::vector<uint64_t> thread_hashes() const { return std::vector<uint64_t>(); }
+};
+
+// Xilinx accelerators visible to OpenCL
+unsigned ocl_device_count();
+
+// xclbin: kernel binary for the device'th Xilinx accelerator
+std::unique_ptr<miner_backend> make_ocl_backend(const std::string& xclbin, unsigned device);
+
+// Where the CPU backend keeps its huge-page copy of the DAG on a NUMA host;
+// with a single node each is one copy.
+enum cpu_dag_placement
+{
+    CPU_DAG_INTERLEAVE,             // one copy, pages spread round-robin over the nodes
+    CPU_DAG_SHARDED,                // one copy, a contiguous range per node
+    CPU_DAG_REPLICATE               // a copy per node, each worker reading its own node's
+};
+
+// threads 0 means one per online CPU
+std::unique_ptr<miner_backend> make_cpu_backend(unsigned threads, cpu_dag_placement placement);
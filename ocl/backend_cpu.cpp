@@ -0,0 +1,307 @@
+/*
+  This file is part of ethash.
+
+  ethash is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  ethash is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with ethash.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file backend_cpu.cpp
+* @date 2026
+*
+* Search batches on CPU threads with ethash_hash_batch. The batch's first
+* hits are reported in the order they fall in it, as ethash_search and the
+* kernel keep them.
+*
+* The workers do not read the mapped DAG file, which sits on 4 KB page-cache
+* pages where nearly every access is a TLB miss: each epoch's DAG is copied,
+* chunk by chunk as it is produced, into ethash_dag_alloc memory on huge
+* pages. On a NUMA host the workers are pinned round-robin to the nodes and
+* the copy is interleaved over them, sharded one range per node, or
+* replicated on every node so each worker reads its own.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <thread>
+#include <unistd.h>
+#include "backend.h"
+#include "../c/dag_alloc.h"
+
+// nonces a worker claims at a time, a multiple of every SIMD width
+static const uint32_t CPU_CHUNK = 4096;
+
+namespace
+{
+
+struct cpu_job
+{
+    search_request request;
+    uint32_t end = 0;               // request.count, or where it was cancelled
+    uint32_t next_chunk = 0;        // first index not yet claimed
+    uint32_t pending = 0;           // claimed chunks still being hashed
+    uint32_t hits = 0;
+    std::vector<ethash_solution> solutions;
+    std::chrono::steady_clock::time_point submitted, started;
+    bool done = false;
+};
+
+class cpu_backend : public miner_backend
+{
+public:
+    cpu_backend(unsigned threads, cpu_dag_placement placement) :
+        threads_(threads), placement_(placement), nodes_(ethash_numa_nodes()) {}
+
+    ~cpu_backend()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+        work_cv_.notify_all();
+        for (unsigned i = 0; i != workers_.size(); ++i)
+            workers_[i].join();
+        release_copies();
+    }
+
+    std::string name() const { return "cpu:" + std::to_string(threads_); }
+
+    bool init(std::string& error)
+    {
+        if (!threads_) {
+            long online = sysconf(_SC_NPROCESSORS_ONLN);
+            threads_ = online > 0 ? (unsigned) online : 1;
+        }
+        worker_hashes_.assign(threads_, 0);
+        for (unsigned i = 0; i != threads_; ++i)
+            workers_.push_back(std::thread(&cpu_backend::work, this, i));
+        (void) error;
+        return true;
+    }
+
+    // Nothing is in flight, so the workers hold no DAG pointer: the old
+    // copies go first, so there are never two epochs' worth at once.
+    bool load_epoch(const epoch_context& ctx, std::string& error)
+    {
+        release_copies();
+        size_t const full_size = ctx.params.full_size;
+        bool const replicate = placement_ == CPU_DAG_REPLICATE && nodes_ > 1;
+        int const numa_node = nodes_ == 1 ? ETHASH_NUMA_ANY
+            : placement_ == CPU_DAG_SHARDED ? ETHASH_NUMA_SHARDED
+            : replicate ? 0 : ETHASH_NUMA_INTERLEAVE;
+        std::vector<ethash_dag_mem> copies(replicate ? nodes_ : 1);
+        if (ethash_dag_alloc(&copies[0], full_size, numa_node) != 0) {
+            error = "unable to allocate " + std::to_string(full_size >> 20) + " MB for the DAG";
+            return false;
+        }
+
+        // every batch reads all of it
+        for (size_t begin = 0; begin < full_size; begin += DAG_CHUNK_BYTES) {
+            size_t const end = std::min(begin + DAG_CHUNK_BYTES, full_size);
+            if (ctx.progress && !ctx.progress->wait(end, error)) {
+                ethash_dag_free(&copies[0]);
+                return false;
+            }
+            memcpy((uint8_t*) copies[0].ptr + begin, (uint8_t const*) ctx.dag + begin, end - begin);
+        }
+        for (unsigned node = 1; node < copies.size(); ++node) {
+            if (ethash_dag_replicate(&copies[node], &copies[0], (int) node) != 0) {
+                for (unsigned k = 0; k != node; ++k)
+                    ethash_dag_free(&copies[k]);
+                error = "unable to replicate the DAG on NUMA node " + std::to_string(node);
+                return false;
+            }
+        }
+
+        std::lock_guard<std::mutex> lock(mutex_);
+        copies_.swap(copies);
+        ctx_ = ctx;
+        ctx_.dag = copies_[0].ptr;
+        ctx_.progress = NULL;
+        return true;
+    }
+
+    // one batch being split across the workers and one queued behind it, so
+    // the workers never wait for the driver between batches
+    unsigned max_in_flight() const { return 2; }
+
+    unsigned compute_units() const { return threads_; }
+
+    void submit(const search_request& request)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            jobs_.push_back(cpu_job());
+            cpu_job& job = jobs_.back();
+            job.request = request;
+            job.end = request.work.generation < cancel_below_ ? 0 : request.count;
+            job.submitted = job.started = std::chrono::steady_clock::now();
+            job.done = job.end == 0;
+        }
+        work_cv_.notify_all();
+    }
+
+    bool poll(search_result& result, bool wait)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        if (jobs_.empty())
+            return false;
+        if (wait)
+            done_cv_.wait(lock, [this]() { return jobs_.front().done; });
+        else if (!jobs_.front().done)
+            return false;
+
+        // chunks finish out of order; the first hits are those earliest in
+        // the batch, which the nonce alone does not say once it wraps
+        cpu_job& job = jobs_.front();
+        uint64_t const start = job.request.start_nonce, stride = job.request.stride;
+        std::sort(job.solutions.begin(), job.solutions.end(),
+                [start, stride](const ethash_solution& a, const ethash_solution& b) {
+                    return (a.nonce - start) / stride < (b.nonce - start) / stride;
+                });
+        if (job.solutions.size() > BATCH_SOLUTIONS)
+            job.solutions.resize(BATCH_SOLUTIONS);
+        result.request = job.request;
+        result.hashed = job.end;
+        result.hits = job.hits;
+        result.solutions.swap(job.solutions);
+        result.started = job.started;
+        auto now = std::chrono::steady_clock::now();
+        result.seconds = std::chrono::duration<double>(now - job.submitted).count();
+        result.device_seconds = job.end ? std::chrono::duration<double>(now - job.started).count() : 0;
+        result.transfer_seconds = 0;
+        jobs_.pop_front();
+        return true;
+    }
+
+    // Workers stop claiming chunks of the cancelled batches; a batch ends once
+    // the chunks already claimed are hashed, at most CPU_CHUNK nonces a worker.
+    void cancel(uint64_t generation)
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        cancel_below_ = std::max(cancel_below_, generation);
+        bool ended = false;
+        for (auto it = jobs_.begin(); it != jobs_.end(); ++it) {
+            if (it->done || it->request.work.generation >= cancel_below_)
+                continue;
+            it->end = it->next_chunk;
+            if (!it->pending) {
+                it->done = true;
+                ended = true;
+            }
+        }
+        if (ended)
+            done_cv_.notify_all();
+    }
+
+    std::vector<uint64_t> thread_hashes() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return worker_hashes_;
+    }
+
+private:
+    // Claims chunks from the oldest job with unclaimed work; the last worker
+    // to finish a job's chunk completes it.
+    void work(unsigned index)
+    {
+        // best effort: an unpinned worker still hashes, only less locally
+        unsigned const home = index % nodes_;
+        if (nodes_ > 1)
+            ethash_numa_pin_thread((int) home);
+        uint64_t nonces[64];
+        ethash_return_value values[64];
+        std::unique_lock<std::mutex> lock(mutex_);
+        for (;;) {
+            cpu_job* job = NULL;
+            for (auto it = jobs_.begin(); it != jobs_.end() && !job; ++it)
+                if (it->next_chunk < it->end)
+                    job = &*it;
+            if (!job) {
+                if (stop_)
+                    return;
+                work_cv_.wait(lock);
+                continue;
+            }
+            uint32_t const first = job->next_chunk;
+            if (!first)
+                job->started = std::chrono::steady_clock::now();
+            uint32_t const last = std::min(job->end, first + CPU_CHUNK);
+            job->next_chunk = last;
+            job->pending++;
+            search_request const request = job->request;
+            epoch_context ctx = ctx_;
+            if (copies_.size() > 1)
+                ctx.dag = copies_[home].ptr;
+            lock.unlock();
+
+            // the chunk's first BATCH_SOLUTIONS hits are all the job can keep
+            std::vector<ethash_solution> found;
+            uint32_t hits = 0;
+            for (uint32_t base = first; base < last; base += 64) {
+                uint32_t const n = std::min<uint32_t>(64, last - base);
+                for (uint32_t k = 0; k != n; ++k)
+                    nonces[k] = request.start_nonce + (uint64_t) (base + k) * request.stride;
+                ethash_hash_batch(values, (node const*) ctx.dag, &ctx.params, request.work.header, nonces, n);
+                for (uint32_t k = 0; k != n; ++k) {
+                    if (ethash_check_difficulty(values[k].result, request.work.boundary) && ++hits <= BATCH_SOLUTIONS) {
+                        ethash_solution sol;
+                        sol.nonce = nonces[k];
+                        sol.value = values[k];
+                        found.push_back(sol);
+                    }
+                }
+            }
+
+            // jobs_ is a deque only appended to at the back and popped from
+            // the front once done, so job stays valid while pending
+            lock.lock();
+            job->hits += hits;
+            worker_hashes_[index] += last - first;
+            job->solutions.insert(job->solutions.end(), found.begin(), found.end());
+            if (--job->pending == 0 && job->next_chunk == job->end) {
+                job->done = true;
+                done_cv_.notify_all();
+            }
+        }
+    }
+
+    void release_copies()
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        for (unsigned i = 0; i != copies_.size(); ++i)
+            ethash_dag_free(&copies_[i]);
+        copies_.clear();
+        ctx_.dag = NULL;
+    }
+
+    unsigned threads_;
+    cpu_dag_placement placement_;
+    unsigned nodes_;
+    std::vector<ethash_dag_mem> copies_;    // one, or one per node when replicated
+    std::vector<std::thread> workers_;
+    mutable std::mutex mutex_;
+    std::condition_variable work_cv_, done_cv_;
+    std::deque<cpu_job> jobs_;
+    std::vector<uint64_t> worker_hashes_;
+    epoch_context ctx_;
+    uint64_t cancel_below_ = 0;
+    bool stop_ = false;
+};
+
+}
+
+std::unique_ptr<miner_backend> make_cpu_backend(unsigned threads, cpu_dag_placement placement)
+{
+    return std::unique_ptr<miner_backend>(new cpu_backend(threads, placement));
+}
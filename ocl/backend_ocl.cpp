@@ -0,0 +1,367 @@
+/*
+  This file is part of ethash.
+
+  ethash is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  ethash is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with ethash.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file backend_ocl.cpp
+* @date 2026
+*
+* krnl_ethash on a Xilinx accelerator through OpenCL/XRT. Also runs under
+* XCL_EMULATION_MODE=sw_emu with an emulation xclbin.
+*/
+
+#include <algorithm>
+#include <chrono>
+#include <deque>
+#include <fstream>
+#include <mutex>
+#include "pow.h"
+#include "backend.h"
+#include "../c/dag_alloc.h"
+
+static_assert(BATCH_SOLUTIONS == SEARCH_SLOTS, "result slots and batch solutions differ");
+
+// batches in flight per compute unit: one running while the previous one is
+// read back
+static const unsigned PIPELINE_DEPTH = 2;
+
+// krnl_ethash arguments before the optional extra DAG shards
+static const cl_uint KERNEL_ARGS = 11;
+
+// compute units probed by instance name, krnl_ethash_1 .. krnl_ethash_<n>
+static const unsigned MAX_COMPUTE_UNITS = 16;
+
+namespace
+{
+
+// from the start of first to the end of last, from the queue's profiling; 0
+// when the runtime has none for the events
+double event_seconds(const cl::Event& first, const cl::Event& last)
+{
+    cl_int err_start, err_end;
+    cl_ulong start = first.getProfilingInfo<CL_PROFILING_COMMAND_START>(&err_start);
+    cl_ulong end = last.getProfilingInfo<CL_PROFILING_COMMAND_END>(&err_end);
+    if (err_start != CL_SUCCESS || err_end != CL_SUCCESS || end < start)
+        return 0;
+    return (end - start) * 1e-9;
+}
+
+double event_seconds(const cl::Event& event)
+{
+    return event_seconds(event, event);
+}
+
+std::vector<cl::Device> xilinx_accelerators()
+{
+    //traversing all Platforms To find Xilinx Platform and targeted
+    //Device in Xilinx Platform
+    std::vector<cl::Platform> platforms;
+    std::vector<cl::Device> devices;
+    cl::Platform::get(&platforms);
+    for (size_t i = 0; i < platforms.size(); i++) {
+        if (platforms[i].getInfo<CL_PLATFORM_NAME>() == "Xilinx") {
+            platforms[i].getDevices(CL_DEVICE_TYPE_ACCELERATOR, &devices);
+            if (!devices.empty())
+                break;
+        }
+    }
+    return devices;
+}
+
+// One in-flight batch and everything it needs, reused round-robin.
+struct batch_slot
+{
+    cl::CommandQueue* queue;
+    cl::Kernel kernel;
+    cl::Buffer buf_res, buf_hdr, buf_bnd;
+    search_request request;     // source of the header write, kept until it completes
+    search_results results;     // destination of the result read
+    cl::Event write_hdr, write_bnd, run, done;
+    std::chrono::steady_clock::time_point submitted;
+};
+
+class ocl_backend : public miner_backend
+{
+public:
+    ocl_backend(const std::string& xclbin, unsigned device) : xclbin_(xclbin), device_index_(device) {}
+
+    ~ocl_backend()
+    {
+        for (unsigned i = 0; i != queues_.size(); ++i)
+            queues_[i].finish();
+    }
+
+    std::string name() const { return "ocl" + std::to_string(device_index_) + ":" + device_name_; }
+
+    bool init(std::string& error)
+    {
+        std::vector<cl::Device> devices = xilinx_accelerators();
+        if (device_index_ >= devices.size()) {
+            error = devices.empty() ? "no Xilinx accelerator found" : "no Xilinx accelerator " + std::to_string(device_index_);
+            return false;
+        }
+        device_ = devices[device_index_];
+        device_name_ = device_.getInfo<CL_DEVICE_NAME>();
+
+        // Batches are ordered by events, not by the queue, so an out-of-order
+        // queue lets the runtime overlap one batch's transfers with another's
+        // kernel; where that is unsupported each slot gets its own in-order
+        // queue instead.
+        context_ = cl::Context(device_);
+        cl_int err;
+        queues_.push_back(cl::CommandQueue(context_, device_, CL_QUEUE_PROFILING_ENABLE | CL_QUEUE_OUT_OF_ORDER_EXEC_MODE_ENABLE, &err));
+        bool const in_order = err != CL_SUCCESS;
+
+        // Load xclbin
+        std::ifstream bin_file(xclbin_.c_str(), std::ifstream::binary);
+        if (!bin_file) {
+            error = "unable to read " + xclbin_;
+            return false;
+        }
+        std::vector<char> bin((std::istreambuf_iterator<char>(bin_file)), std::istreambuf_iterator<char>());
+        cl::Program::Binaries bins;
+        bins.push_back({bin.data(), bin.size()});
+        devices.resize(1);
+        devices[0] = device_;
+        program_ = cl::Program(context_, devices, bins, NULL, &err);
+        if (err != CL_SUCCESS) {
+            error = "unable to program the device with " + xclbin_;
+            return false;
+        }
+
+        // Every compute unit linked into the xclbin gets its own slots, bound
+        // to it by instance name, so batches are spread over all of them. A
+        // binary whose instance names differ is run through the plain kernel
+        // name and left to the runtime to place.
+        std::vector<std::string> cu_names;
+        for (unsigned cu = 1; cu <= MAX_COMPUTE_UNITS; ++cu) {
+            std::string cu_name = "krnl_ethash:{krnl_ethash_" + std::to_string(cu) + "}";
+            cl::Kernel probe(program_, cu_name.c_str(), &err);
+            if (err != CL_SUCCESS)
+                break;
+            cu_names.push_back(cu_name);
+        }
+        if (cu_names.empty())
+            cu_names.push_back("krnl_ethash");
+        compute_units_ = (unsigned) cu_names.size();
+
+        if (in_order) {
+            queues_.clear();
+            for (unsigned i = 0; i != compute_units_ * PIPELINE_DEPTH; ++i)
+                queues_.push_back(cl::CommandQueue(context_, device_, CL_QUEUE_PROFILING_ENABLE));
+        }
+
+        // The abort word every kernel polls between groups of nonces. It has
+        // a queue of its own, so a raise is not ordered behind the batches it
+        // is meant to cut short.
+        cl_ulong const none = 0;
+        buf_cancel_ = cl::Buffer(context_, CL_MEM_READ_ONLY | CL_MEM_COPY_HOST_PTR, sizeof(none), const_cast<cl_ulong*>(&none), &err);
+        if (err != CL_SUCCESS) {
+            error = "unable to allocate the cancel flag";
+            return false;
+        }
+        cancel_queue_ = cl::CommandQueue(context_, device_, 0);
+
+        // Each slot owns a kernel object and its small buffers, so the
+        // arguments and header of the next batch are set while the previous
+        // batch still runs. Consecutive slots go to different compute units.
+        slots_.resize(compute_units_ * PIPELINE_DEPTH);
+        for (unsigned i = 0; i != slots_.size(); ++i) {
+            batch_slot& slot = slots_[i];
+            slot.queue = &queues_[i % queues_.size()];
+            slot.kernel = cl::Kernel(program_, cu_names[i % compute_units_].c_str());
+            slot.buf_res = cl::Buffer(context_, CL_MEM_WRITE_ONLY, sizeof(search_results));
+            slot.buf_hdr = cl::Buffer(context_, CL_MEM_READ_ONLY, 32);
+            slot.buf_bnd = cl::Buffer(context_, CL_MEM_READ_ONLY, 32);
+            slot.kernel.setArg(0, slot.buf_res);
+            slot.kernel.setArg(2, slot.buf_hdr);
+            slot.kernel.setArg(3, slot.buf_bnd);
+            slot.kernel.setArg(9, buf_cancel_);
+        }
+        return true;
+    }
+
+    bool load_epoch(const epoch_context& ctx, std::string& error)
+    {
+        // A kernel built with DAG_SHARDS > 1 takes the extra shards as
+        // trailing arguments; each shard is a page-aligned range of the
+        // mapping, so the split costs no copy. The DAG moves once; every
+        // batch afterwards only moves 64 bytes in and the result slots out.
+        cl_uint num_args = slots_[0].kernel.getInfo<CL_KERNEL_NUM_ARGS>();
+        unsigned shards = num_args > KERNEL_ARGS ? num_args - KERNEL_ARGS + 1 : 1;
+        size_t shard_bytes = ethash_dag_shard_bytes(ctx.params.full_size, shards, 4096);
+        buf_dag_.clear();
+        for (unsigned k = 0; k != shards; ++k) {
+            size_t offset = k * shard_bytes;
+            if (offset >= ctx.params.full_size) {
+                buf_dag_.push_back(buf_dag_[0]); // nothing left for this bank, never read
+                continue;
+            }
+            size_t size = std::min(shard_bytes, (size_t) ctx.params.full_size - offset);
+            cl_int err;
+            buf_dag_.push_back(cl::Buffer(context_, CL_MEM_READ_ONLY | CL_MEM_USE_HOST_PTR, size,
+                    (uint8_t*) const_cast<void*>(ctx.dag) + offset, &err));
+            if (err != CL_SUCCESS) {
+                error = "unable to allocate DAG shard " + std::to_string(k);
+                return false;
+            }
+        }
+
+        cl_uint num_full_pages = (cl_uint) (ctx.params.full_size / 128);
+        cl_uint shard_pages = (cl_uint) (shard_bytes / 128);
+        for (unsigned i = 0; i != slots_.size(); ++i) {
+            slots_[i].kernel.setArg(1, buf_dag_[0]);
+            slots_[i].kernel.setArg(7, num_full_pages);
+            slots_[i].kernel.setArg(8, shard_pages);
+            for (unsigned k = 1; k != shards; ++k)
+                slots_[i].kernel.setArg(KERNEL_ARGS + k - 1, buf_dag_[k]);
+        }
+        // After setArg, so the runtime places each shard in its port's bank.
+        // Each shard moves in DAG_CHUNK_BYTES sub-buffers, each migrated as
+        // soon as the producer has it final, so the transfer of one chunk
+        // overlaps reading or generating the next.
+        std::vector<cl::Buffer> chunks;
+        for (unsigned k = 0; k != shards; ++k) {
+            size_t offset = k * shard_bytes;
+            if (offset >= ctx.params.full_size)
+                break;
+            size_t size = std::min(shard_bytes, (size_t) ctx.params.full_size - offset);
+            for (size_t begin = 0; begin < size; begin += DAG_CHUNK_BYTES) {
+                cl_buffer_region region = {begin, std::min(DAG_CHUNK_BYTES, size - begin)};
+                if (ctx.progress && !ctx.progress->wait(offset + region.origin + region.size, error)) {
+                    queues_[0].finish();
+                    return false;
+                }
+                cl_int err;
+                chunks.push_back(buf_dag_[k].createSubBuffer(CL_MEM_READ_ONLY, CL_BUFFER_CREATE_TYPE_REGION, &region, &err));
+                if (err != CL_SUCCESS) {
+                    queues_[0].finish();
+                    error = "unable to create a sub-buffer of DAG shard " + std::to_string(k);
+                    return false;
+                }
+                std::vector<cl::Memory> migrate(1, chunks.back());
+                queues_[0].enqueueMigrateMemObjects(migrate, 0/* 0 means from host*/);
+                queues_[0].flush();
+            }
+        }
+        queues_[0].finish();
+        return true;
+    }
+
+    unsigned max_in_flight() const { return (unsigned) slots_.size(); }
+
+    unsigned compute_units() const { return compute_units_; }
+
+    // Per batch: write header and boundary, run the kernel once both land,
+    // read the results once it ends. The host only ever waits on the oldest
+    // slot's final event. New work reaches the device with the header write
+    // of the next batch; stale batches stop through the abort word below.
+    void submit(const search_request& request)
+    {
+        unsigned const s = next_slot_;
+        next_slot_ = (next_slot_ + 1) % slots_.size();
+        batch_slot& slot = slots_[s];
+        slot.request = request;
+        slot.submitted = std::chrono::steady_clock::now();
+        slot.kernel.setArg(4, (cl_ulong) request.start_nonce);
+        slot.kernel.setArg(5, (cl_uint) request.count);
+        slot.kernel.setArg(6, (cl_uint) request.stride);
+        slot.kernel.setArg(10, (cl_ulong) request.work.generation);
+
+        slot.queue->enqueueWriteBuffer(slot.buf_hdr, CL_FALSE, 0, 32, slot.request.work.header, NULL, &slot.write_hdr);
+        slot.queue->enqueueWriteBuffer(slot.buf_bnd, CL_FALSE, 0, 32, slot.request.work.boundary, NULL, &slot.write_bnd);
+        std::vector<cl::Event> inputs(1, slot.write_hdr);
+        inputs.push_back(slot.write_bnd);
+        slot.queue->enqueueTask(slot.kernel, &inputs, &slot.run);
+        std::vector<cl::Event> ran(1, slot.run);
+        slot.queue->enqueueReadBuffer(slot.buf_res, CL_FALSE, 0, sizeof(search_results), &slot.results, &ran, &slot.done);
+        slot.queue->flush();
+        in_flight_.push_back(s);
+    }
+
+    // Raises the abort word to generation. A running kernel sees it before
+    // its next group of DAG_IN_FLIGHT nonces and ends early, a queued one
+    // ends as it starts; either way poll reports what was hashed.
+    void cancel(uint64_t generation)
+    {
+        std::lock_guard<std::mutex> lock(cancel_mutex_);
+        if (generation <= cancel_below_)
+            return;
+        cancel_below_ = generation;
+        cl_ulong const value = generation;
+        cancel_queue_.enqueueWriteBuffer(buf_cancel_, CL_TRUE, 0, sizeof(value), &value);
+    }
+
+    bool poll(search_result& result, bool wait)
+    {
+        if (in_flight_.empty())
+            return false;
+        batch_slot& slot = slots_[in_flight_.front()];
+        if (!wait && slot.done.getInfo<CL_EVENT_COMMAND_EXECUTION_STATUS>() != CL_COMPLETE)
+            return false;
+        slot.done.wait();
+        auto now = std::chrono::steady_clock::now();
+        in_flight_.pop_front();
+
+        result.request = slot.request;
+        result.hashed = slot.results.hashed;
+        result.hits = slot.results.count;
+        result.solutions.clear();
+        for (cl_uint i = 0; i < slot.results.count && i < SEARCH_SLOTS; i++) {
+            const solution& sol = slot.results.slots[i];
+            ethash_solution out;
+            out.nonce = sol.nonce;
+            memcpy(out.value.mix_hash, sol.mix, 32);
+            memcpy(out.value.result, sol.hash, 32);
+            result.solutions.push_back(out);
+        }
+        // the kernel's start, dated back from completion on the device clock
+        result.started = std::max(slot.submitted, now - std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+                std::chrono::duration<double>(event_seconds(slot.run, slot.done))));
+        result.seconds = std::chrono::duration<double>(now - slot.submitted).count();
+        result.device_seconds = event_seconds(slot.run);
+        result.transfer_seconds = event_seconds(slot.write_hdr) + event_seconds(slot.write_bnd) + event_seconds(slot.done);
+        return true;
+    }
+
+private:
+    std::string xclbin_;
+    unsigned device_index_;
+    std::string device_name_;
+    cl::Device device_;
+    cl::Context context_;
+    std::vector<cl::CommandQueue> queues_;
+    cl::Program program_;
+    std::vector<cl::Buffer> buf_dag_;     // one per DAG shard
+    cl::Buffer buf_cancel_;               // generations below it are abandoned
+    cl::CommandQueue cancel_queue_;
+    std::mutex cancel_mutex_;
+    uint64_t cancel_below_ = 0;
+    unsigned compute_units_ = 1;
+    std::vector<batch_slot> slots_;
+    unsigned next_slot_ = 0;
+    std::deque<unsigned> in_flight_;
+};
+
+}
+
+unsigned ocl_device_count()
+{
+    return (unsigned) xilinx_accelerators().size();
+}
+
+std::unique_ptr<miner_backend> make_ocl_backend(const std::string& xclbin, unsigned device)
+{
+    return std::unique_ptr<miner_backend>(new ocl_backend(xclbin, device));
+}
@@ -0,0 +1,184 @@
+/*
+  This file is part of ethash.
+
+  ethash is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  ethash is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with ethash.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file backend_ocl_test.cpp
+* @date 2026
+*
+* The OpenCL backend's batch pipeline on an emulated device: a DAG small
+* enough to build in milliseconds, a full pipeline of batches returned in
+* order with every solution held to ethash_hash, batches on stale work
+* ending without hashing, and batches in flight cut short by cancel with
+* what they hashed reported. An all-ones boundary makes every nonce a hit,
+* so hits must equal hashed and the solutions kept must be the batch's first
+* nonces. Exits non-zero on the first failed check.
+*
+*   XCL_EMULATION_MODE=sw_emu ./backend_ocl_test krnl_ethash.xclbin
+*
+* with emconfig.json in the working directory; ocl/emu.sh builds and runs it.
+* Not for a kernel built with ETHASH_FULL_PAGES, whose page count is fixed.
+*/
+
+#include <stdlib.h>
+#include <string.h>
+#include <algorithm>
+#include <iostream>
+#include <memory>
+#include <string>
+#include "backend.h"
+
+// 256 pages, so the page index is taken modulo a small DAG
+static const uint64_t TINY_CACHE_SIZE = 1024;
+static const uint64_t TINY_FULL_SIZE = 32 * 1024;
+
+// several groups of the kernel's DAG_IN_FLIGHT, and a partial one
+static const uint32_t BATCH_NONCES = 300;
+
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            std::cout << "backend_ocl test failed: " << #cond << " (line " << __LINE__ << ")" << std::endl; \
+            return 1; \
+        } \
+    } while (0)
+
+namespace
+{
+
+search_request make_request(uint64_t generation, uint64_t start_nonce, uint32_t count)
+{
+    search_request request;
+    memset(request.work.header, 0, 32);
+    request.work.header[0] = (uint8_t) generation;
+    memset(request.work.boundary, 0xff, 32);
+    request.work.epoch = 0;
+    request.work.generation = generation;
+    request.start_nonce = start_nonce;
+    request.stride = 3;
+    request.count = count;
+    return request;
+}
+
+// every solution is one of the batch's nonces and matches the host
+bool solutions_match(const search_result& result, const node* full, const ethash_params& params)
+{
+    const search_request& request = result.request;
+    for (unsigned i = 0; i != result.solutions.size(); ++i) {
+        const ethash_solution& sol = result.solutions[i];
+        if (sol.nonce < request.start_nonce || (sol.nonce - request.start_nonce) % request.stride != 0
+                || (sol.nonce - request.start_nonce) / request.stride >= result.hashed)
+            return false;
+        ethash_return_value expect;
+        ethash_hash(&expect, full, &params, request.work.header, sol.nonce);
+        if (memcmp(expect.mix_hash, sol.value.mix_hash, 32) != 0 || memcmp(expect.result, sol.value.result, 32) != 0)
+            return false;
+    }
+    return true;
+}
+
+// every nonce is a hit, so the solutions kept are the batch's first nonces
+bool first_hits_kept(const search_result& result)
+{
+    const search_request& request = result.request;
+    for (unsigned i = 0; i != result.solutions.size(); ++i)
+        if (result.solutions[i].nonce != request.start_nonce + (uint64_t) i * request.stride)
+            return false;
+    return true;
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    if (argc != 2) {
+        std::cout << "Usage: " << argv[0] << " <emulation xclbin>" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    ethash_params params;
+    params.cache_size = TINY_CACHE_SIZE;
+    params.full_size = TINY_FULL_SIZE;
+    uint8_t seed[32];
+    ethash_get_seedhash(seed, 0);
+    ethash_cache cache;
+    cache.mem = malloc(params.cache_size);
+    // page-aligned, as the backend maps it for the device without a copy
+    void* full = aligned_alloc(4096, params.full_size);
+    CHECK(cache.mem && full);
+    ethash_mkcache(&cache, &params, seed);
+    ethash_compute_full_data(full, &params, &cache);
+
+    std::unique_ptr<miner_backend> backend = make_ocl_backend(argv[1], 0);
+    std::string error;
+    if (!backend->init(error)) {
+        std::cout << "backend_ocl test failed: " << error << std::endl;
+        return 1;
+    }
+    epoch_context ctx;
+    ctx.epoch = 0;
+    ctx.params = params;
+    ctx.dag = full;
+    ctx.progress = NULL;
+    CHECK(backend->load_epoch(ctx, error));
+
+    // a full pipeline, back in submission order, every nonce hashed
+    unsigned const depth = backend->max_in_flight();
+    CHECK(depth >= 2);
+    for (unsigned i = 0; i != depth; ++i)
+        backend->submit(make_request(1, i * 10000, BATCH_NONCES));
+    search_result result;
+    for (unsigned i = 0; i != depth; ++i) {
+        CHECK(backend->poll(result, true));
+        CHECK(result.request.start_nonce == i * 10000);
+        CHECK(result.hashed == BATCH_NONCES && result.hits == BATCH_NONCES);
+        CHECK(result.solutions.size() == BATCH_SOLUTIONS);
+        CHECK(first_hits_kept(result));
+        CHECK(solutions_match(result, (const node*) full, params));
+    }
+    CHECK(!backend->poll(result, false));
+
+    // work of generation 2 and below is stale: a batch on it ends without
+    // hashing, one on generation 3 runs in full
+    backend->cancel(3);
+    backend->submit(make_request(2, 0, BATCH_NONCES));
+    backend->submit(make_request(3, 0, BATCH_NONCES));
+    CHECK(backend->poll(result, true));
+    CHECK(result.hashed == 0 && result.hits == 0 && result.solutions.empty());
+    CHECK(backend->poll(result, true));
+    CHECK(result.hashed == BATCH_NONCES && result.hits == BATCH_NONCES);
+    CHECK(solutions_match(result, (const node*) full, params));
+
+    // cancelled while in flight: each batch ends after what it started, and
+    // reports exactly that
+    for (unsigned i = 0; i != depth; ++i)
+        backend->submit(make_request(4, i * 100000, 20 * BATCH_NONCES));
+    backend->cancel(5);
+    for (unsigned i = 0; i != depth; ++i) {
+        CHECK(backend->poll(result, true));
+        CHECK(result.hashed <= 20 * BATCH_NONCES && result.hits == result.hashed);
+        CHECK(result.solutions.size() == std::min<size_t>(result.hashed, BATCH_SOLUTIONS));
+        CHECK(first_hits_kept(result));
+        CHECK(solutions_match(result, (const node*) full, params));
+    }
+    backend->submit(make_request(5, 0, BATCH_NONCES));
+    CHECK(backend->poll(result, true));
+    CHECK(result.hashed == BATCH_NONCES);
+
+    backend.reset();
+    free(full);
+    free(cache.mem);
+    std::cout << "backend_ocl test passed" << std::endl;
+    return 0;
+}
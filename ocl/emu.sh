@@ -0,0 +1,62 @@
+#!/bin/bash
+# Builds krnl_ethash and the host for Vitis software or hardware emulation,
+# runs backend_ocl_test, the OpenCL backend's double-buffered submit, poll
+# and cancel on a small DAG, and mines briefly: before it mines, pow runs
+# check_backend, a known-answer batch held to c/ethash.c and to the
+# published block 22 result, on every unit. A clean exit is a pass.
+#
+#   source <vitis>/settings64.sh; source <xrt>/setup.sh
+#   PLATFORM=<platform name or .xpfm> ocl/emu.sh [sw_emu|hw_emu] [shards] [full_pages]
+#
+# shards is DAG_SHARDS, 1 to 4, each shard on its own DDR bank. full_pages
+# builds a single-epoch kernel with ETHASH_FULL_PAGES, the epoch's
+# full_size / 128 (8388593 for epoch 0); it only mines blocks of that epoch,
+# BLOCK (default 0), and skips backend_ocl_test. DAG files go to DAG_DIR,
+# default the build directory, and are generated there on the first run.
+
+set -e
+TARGET=${1:-sw_emu}
+SHARDS=${2:-1}
+FULL_PAGES=${3:-}
+BLOCK=${BLOCK:-0}
+: "${PLATFORM:?set PLATFORM to the platform to build for}"
+: "${XILINX_XRT:?source the XRT setup.sh first}"
+case $TARGET in
+sw_emu|hw_emu) ;;
+*) echo "target is sw_emu or hw_emu, not $TARGET" >&2; exit 1;;
+esac
+
+SRC=$(cd "$(dirname "$0")" && pwd)
+BUILD=${BUILD:-$SRC/_emu/$TARGET-$SHARDS${FULL_PAGES:+-$FULL_PAGES}}
+DAG_DIR=${DAG_DIR:-$BUILD}
+mkdir -p "$BUILD" "$DAG_DIR"
+cd "$BUILD"
+
+# kernel: one compute unit, krnl_ethash_1, shard k of the DAG on bank k
+DEFINES="-DDAG_SHARDS=$SHARDS${FULL_PAGES:+ -DETHASH_FULL_PAGES=$FULL_PAGES}"
+PORTS=""
+for ((k = 0; k < SHARDS; ++k)); do
+    PORTS="$PORTS --connectivity.sp krnl_ethash_1.dag$k:DDR[$k]"
+done
+v++ -t "$TARGET" --platform "$PLATFORM" -c -k krnl_ethash $DEFINES -I"$SRC" -o krnl_ethash.xo "$SRC/krnl_ethash.cl"
+v++ -t "$TARGET" --platform "$PLATFORM" -l --connectivity.nk krnl_ethash:1:krnl_ethash_1 $PORTS -o krnl_ethash.xclbin krnl_ethash.xo
+emconfigutil --platform "$PLATFORM" --od .
+
+# host: the miner as shipped, on the XRT OpenCL runtime
+for c in ethash io dag_alloc selftest verify; do
+    gcc -O2 -pthread -c "$SRC/../c/$c.c" -o "$c.o"
+done
+C_OBJS="ethash.o io.o dag_alloc.o selftest.o verify.o"
+HOST_SOURCES="pow.cpp backend_cpu.cpp backend_ocl.cpp epoch.cpp scheduler.cpp stratum.cpp telemetry.cpp"
+g++ -std=c++14 -O2 -pthread -I"$XILINX_XRT/include" $(printf "$SRC/%s " $HOST_SOURCES) $C_OBJS \
+    -L"$XILINX_XRT/lib" -lOpenCL -o pow
+g++ -std=c++14 -O2 -pthread -I"$XILINX_XRT/include" "$SRC/backend_ocl_test.cpp" "$SRC/backend_ocl.cpp" ethash.o dag_alloc.o \
+    -L"$XILINX_XRT/lib" -lOpenCL -o backend_ocl_test
+
+# emconfig.json is found in the working directory
+export XCL_EMULATION_MODE=$TARGET
+if [ -z "$FULL_PAGES" ]; then
+    ./backend_ocl_test krnl_ethash.xclbin
+fi
+# check_backend, then 2^20 nonces
+./pow krnl_ethash.xclbin "$BLOCK" "$DAG_DIR" 1 < /dev/null
@@ -0,0 +1,216 @@
+/*
+  This file is part of ethash.
+
+  ethash is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  ethash is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with ethash.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file epoch.cpp
+* @date 2026
+*/
+
+#include <sys/resource.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <set>
+#include <thread>
+#include "epoch.h"
+
+static const uint32_t NO_EPOCH = UINT32_MAX;
+
+// how often the background thread looks whether the previous epoch is gone
+static const double RELEASE_POLL_SECONDS = 1;
+
+struct epoch_manager::state
+{
+    std::string dag_dir;
+    int dag_flags;                      // for ethash_dag_stream
+    std::mutex mutex;
+    std::condition_variable changed;
+    std::shared_ptr<const epoch_dag> current, next;
+    std::weak_ptr<const epoch_dag> previous;    // until the last unit lets go
+    std::set<uint32_t> preparing;               // epochs some thread is preparing
+    uint32_t failed = NO_EPOCH;                 // next epoch the background could not prepare
+    bool stop = false;
+};
+
+bool epoch_dag::wait(size_t end, std::string& error) const
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    changed_.wait(lock, [&] { return ready_ >= end || done_; });
+    if (ready_ >= end)
+        return true;
+    error = error_;
+    return false;
+}
+
+bool epoch_dag::wait_mapped(std::string& error) const
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    changed_.wait(lock, [&] { return mapped_ || done_; });
+    if (mapped_)
+        return true;
+    error = error_;
+    return false;
+}
+
+bool epoch_dag::failed() const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return failed_;
+}
+
+void epoch_dag::progress(void* arg, ethash_dag_file const* file, size_t ready)
+{
+    epoch_dag* dag = (epoch_dag*) arg;
+    std::lock_guard<std::mutex> lock(dag->mutex_);
+    if (!dag->mapped_) {
+        dag->ctx.dag = file->data;
+        dag->mapped_ = true;
+    }
+    dag->ready_ = ready;
+    if (ready == dag->ctx.params.full_size)
+        dag->prepare_seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - dag->created_).count();
+    dag->changed_.notify_all();
+}
+
+void epoch_dag::finish(const std::string& error)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    done_ = true;
+    failed_ = !error.empty();
+    error_ = error;
+    changed_.notify_all();
+}
+
+// Streams the DAG into its mapping; holds it until done, however early the
+// units let go. Generation threads inherit this thread's priority.
+static void produce(std::shared_ptr<epoch_dag> dag, std::string dag_dir, int flags, bool background)
+{
+    if (background)
+        setpriority(PRIO_PROCESS, (id_t) syscall(SYS_gettid), 19);
+    uint32_t const block_number = dag->ctx.epoch * ETHASH_EPOCH_LENGTH;
+    // an existing file is checksummed as it is read in, unless ETHASH_DAG_NO_VERIFY
+    ethash_io_rc rc = ethash_dag_stream(&dag->file, dag_dir.c_str(), block_number, flags, DAG_CHUNK_BYTES, epoch_dag::progress, dag.get());
+    std::string error;
+    if (rc == ETHASH_IO_CORRUPT)
+        error = "the DAG file of epoch " + std::to_string(dag->ctx.epoch) + " in " + dag_dir + " is corrupt; removed, it is generated on the next acquire";
+    else if (rc != ETHASH_IO_OK)
+        error = "unable to prepare the DAG of epoch " + std::to_string(dag->ctx.epoch) + " in " + dag_dir + ": " + ethash_io_rc_name(rc);
+    dag->finish(error);
+}
+
+// The epoch's DAG as soon as it is mapped, with a thread left producing it.
+static std::shared_ptr<const epoch_dag> prepare_epoch(const std::string& dag_dir, int flags, uint32_t epoch, bool background,
+        std::string& error)
+{
+    std::shared_ptr<epoch_dag> dag(new epoch_dag());
+    dag->ctx.epoch = epoch;
+    dag->ctx.params = ethash_get_params(epoch * ETHASH_EPOCH_LENGTH);
+    dag->ctx.dag = NULL;
+    dag->ctx.progress = dag.get();
+    std::thread(produce, dag, dag_dir, flags, background).detach();
+    if (!dag->wait_mapped(error))
+        return std::shared_ptr<const epoch_dag>();
+    return dag;
+}
+
+// Prepares the epoch after the current one, once the one before it is
+// unmapped, and leaves it to be produced at the lowest priority.
+void epoch_manager::precompute(std::shared_ptr<state> s)
+{
+    std::unique_lock<std::mutex> lock(s->mutex);
+    for (;;) {
+        uint32_t const want = s->current ? s->current->ctx.epoch + 1 : NO_EPOCH;
+        // never alongside a foreground preparation, which has the disk and CPUs
+        bool const idle = want == NO_EPOCH || want == s->failed || !s->preparing.empty()
+                || (s->next && s->next->ctx.epoch == want);
+        if (s->stop)
+            return;
+        if (idle || !s->previous.expired()) {
+            s->changed.wait_for(lock, std::chrono::duration<double>(RELEASE_POLL_SECONDS));
+            continue;
+        }
+        s->next.reset();                // a stale next epoch, after a jump
+        s->preparing.insert(want);
+        lock.unlock();
+        std::string error;
+        std::shared_ptr<const epoch_dag> dag = prepare_epoch(s->dag_dir, s->dag_flags, want, true, error);
+        lock.lock();
+        s->preparing.erase(want);
+        bool const still_next = s->current && s->current->ctx.epoch + 1 == want;
+        if (!dag)
+            s->failed = want;             // left to the units to retry in the foreground
+        else if (still_next)
+            s->next = dag;                // otherwise current jumped meanwhile: dropped
+        s->changed.notify_all();
+    }
+}
+
+epoch_manager::epoch_manager(const std::string& dag_dir, int dag_flags) : state_(new state())
+{
+    state_->dag_dir = dag_dir;
+    state_->dag_flags = dag_flags;
+    std::thread(precompute, state_).detach();
+}
+
+epoch_manager::~epoch_manager()
+{
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    state_->stop = true;
+    state_->changed.notify_all();
+}
+
+std::shared_ptr<const epoch_dag> epoch_manager::acquire(uint32_t epoch, std::string& error)
+{
+    state& s = *state_;
+    std::unique_lock<std::mutex> lock(s.mutex);
+    for (;;) {
+        if (s.current && s.current->failed()) {
+            s.previous = s.current;       // still held by the units that loaded it
+            s.current.reset();
+        }
+        if (s.current && s.current->ctx.epoch == epoch)
+            return s.current;
+        if (s.next && s.next->failed())
+            s.next.reset();               // retried in the foreground below
+        if (s.next && s.next->ctx.epoch == epoch) {
+            s.previous = s.current;
+            s.current = s.next;
+            s.next.reset();
+            s.changed.notify_all();
+            return s.current;
+        }
+        if (s.preparing.count(epoch)) {
+            s.changed.wait(lock);
+            continue;
+        }
+
+        // not prepared ahead: produced at normal priority
+        s.preparing.insert(epoch);
+        lock.unlock();
+        std::shared_ptr<const epoch_dag> dag = prepare_epoch(s.dag_dir, s.dag_flags, epoch, false, error);
+        lock.lock();
+        s.preparing.erase(epoch);
+        s.changed.notify_all();
+        if (!dag)
+            return dag;
+        s.previous = s.current;
+        s.current = dag;
+        if (s.next && s.next->ctx.epoch != epoch + 1)
+            s.next.reset();
+        return s.current;
+    }
+}
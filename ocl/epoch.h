@@ -0,0 +1,101 @@
+/*
+  This file is part of ethash.
+
+  ethash is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  ethash is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with ethash.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file epoch.h
+* @date 2026
+*
+* DAG files of the epoch being mined and the one after it. While an epoch is
+* mined, a background thread at the lowest CPU priority prepares the next
+* one's DAG file, so the switch at the first block of the new epoch only
+* costs draining the batches in flight and loading the new DAG onto each
+* device. At most two epochs are mapped: the next one is not started until
+* every unit has let go of the previous one.
+*
+* A DAG is handed out as soon as it is mapped, while a producer thread still
+* reads it in or generates it DAG_CHUNK_BYTES at a time; backends upload each
+* chunk as it becomes final, so the time to the first hash is that of the
+* slower of producing and uploading, not their sum.
+*/
+#pragma once
+
+#include <stdint.h>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include "backend.h"
+#include "../c/io.h"
+
+// A mapped DAG file; unmapped when the last unit using it, and its
+// producer, let go.
+struct epoch_dag : dag_progress
+{
+    epoch_context ctx;                  // ctx.progress is this DAG
+    ethash_dag_file file;               // the producer's until it is done
+    double prepare_seconds = 0;         // to read it in or generate it; set once all of it is final
+
+    epoch_dag() { memset(&file, 0, sizeof(file)); }
+    epoch_dag(const epoch_dag&) = delete;
+    epoch_dag& operator=(const epoch_dag&) = delete;
+    ~epoch_dag() { ethash_dag_close(&file); }
+
+    bool wait(size_t end, std::string& error) const;
+
+    // Producer side: ethash_dag_stream progress, then the outcome.
+    static void progress(void* arg, ethash_dag_file const* file, size_t ready);
+    void finish(const std::string& error);
+
+    // Blocks until ctx.dag is mapped; false with a reason if it never will be.
+    bool wait_mapped(std::string& error) const;
+
+    bool failed() const;
+
+private:
+    mutable std::mutex mutex_;
+    mutable std::condition_variable changed_;
+    std::chrono::steady_clock::time_point created_ = std::chrono::steady_clock::now();
+    bool mapped_ = false;
+    bool done_ = false;
+    bool failed_ = false;
+    size_t ready_ = 0;
+    std::string error_;
+};
+
+class epoch_manager
+{
+public:
+    // dag_flags go to ethash_dag_stream: ETHASH_DAG_NO_VERIFY trusts existing
+    // files, so a restart hashes as soon as they are read in, not once all of
+    // them has been checksummed.
+    epoch_manager(const std::string& dag_dir, int dag_flags);
+    ~epoch_manager();
+
+    // DAG of the epoch, made current. The prepared next epoch is handed over
+    // at once; any other epoch is prepared in the calling thread, or waited
+    // for when another thread is already on it. Null with a reason on failure.
+    // A DAG whose production failed is dropped, so acquiring its epoch again
+    // starts over; a corrupt file is regenerated then.
+    std::shared_ptr<const epoch_dag> acquire(uint32_t epoch, std::string& error);
+
+private:
+    // shared with the background thread, which may outlive the manager when
+    // it is destroyed in the middle of generating a DAG
+    struct state;
+    static void precompute(std::shared_ptr<state> s);
+
+    std::shared_ptr<state> state_;
+};
@@ -6,288 +6,303 @@
 //
 
 /*
- * BEGIN code from all headers
+ * Constants, Keccak and the mix steps are the ones the CPU build uses;
+ * build with the repository root or c/ on the include path.
  */
+#include "../c/ethash_core.h"
 
-#define MIX_BYTES 128
-#define HASH_BYTES 64
-#define DATASET_PARENTS 256
-#define CACHE_ROUNDS 3
-#define ACCESSES 64
-
-/*
- * BEGIN from fnv.h
- */
-
-#define FNV_PRIME 0x01000193
-
-static inline uint fnv_hash(const uint x, const uint y) {
-	return x*FNV_PRIME ^ y;
-}
-
-/*
- * END from fnv.h
- */
+typedef union
+{
+	uchar bytes[32 / sizeof(uchar)];
+	uint words[32 / sizeof(uint)];
+	ulong double_words[32 / sizeof(ulong)];
+} hash32_t;
 
-/*
- * BEGIN from sha3.h
- */
+// 512-bit words: one DAG page is MIX_NODES beats on a widened memory port
+typedef union
+{
+	ulong8 v;
+	ulong double_words[8];
+	uint words[16];
+} word512_t;
 
-#define decsha3(bits) \
-		int sha3_##bits(uchar*, size_t, const uchar*, size_t);
+// compressed mix, 256 bits
+typedef union
+{
+	uint8 v;
+	ulong double_words[4];
+	uint words[8];
+} word256_t;
 
-decsha3(256)
-decsha3(512)
+// the first SEARCH_SLOTS hits are kept, as ethash_search keeps them; count
+// keeps the total
+#define SEARCH_SLOTS 8
 
-static inline void SHA3_256(uchar * const ret, uchar const *data, const size_t size) {
-	sha3_256(ret, 32, data, size);
-}
+typedef struct
+{
+	ulong nonce;
+	ulong pad[3]; // keeps mix 32-byte aligned, layout mirrored in pow.h
+	hash32_t mix;
+	hash32_t hash;
+} solution_t;
 
-static inline void SHA3_512(uchar * const ret, uchar const *data, const size_t size) {
-	sha3_512(ret, 64, data, size);
+typedef struct
+{
+	uint count;
+	uint hashed; // nonces hashed, count unless the batch was cancelled
+	uint pad[6];
+	solution_t slots[SEARCH_SLOTS];
+} search_results_t;
+
+// hash <= boundary, both big-endian
+static bool check_difficulty(const hash32_t* hash, const hash32_t* boundary)
+{
+	for (unsigned i = 0; i < 32; i++) {
+		if (hash->bytes[i] != boundary->bytes[i]) {
+			return hash->bytes[i] < boundary->bytes[i];
+		}
+	}
+	return true;
 }
 
 /*
- * END from sha3.h
+ * The hash is split into three stages connected by pipes and run as a
+ * dataflow region, so each is a separate pipelined process:
+ *
+ *   seed_stage:  Keccak-512(header || nonce), one nonce per cycle
+ *   dag_stage:   the 64 DAG accesses, interleaved over DAG_IN_FLIGHT nonces,
+ *                one page every MIX_NODES cycles
+ *   final_stage: Keccak-256(seed || compressed mix) and the boundary check
+ *
+ * The 64 accesses of one nonce depend on each other, but those of different
+ * nonces do not: dag_stage issues access i for every nonce of its group
+ * before access i + 1, so DAG_IN_FLIGHT page reads are outstanding at once
+ * and memory latency is hidden instead of serialized.
+ *
+ * Nonces go through in groups of DAG_IN_FLIGHT, each announced on a control
+ * pipe and a zero group ending the batch. Before each group seed_stage reads
+ * the host's abort word: once the host has raised it above the batch's
+ * generation the work is stale, and the batch ends after the groups already
+ * started, with the nonces actually hashed reported back.
  */
 
-/*
- * BEGIN from internal.h
- */
-
-// compile time settings
-#define NODE_WORDS (64/4)
-#define MIX_WORDS (MIX_BYTES/4)
-#define MIX_NODES (MIX_WORDS / NODE_WORDS)
+// nonces interleaved by dag_stage; enough to cover DDR/HBM read latency
+#ifndef DAG_IN_FLIGHT
+#define DAG_IN_FLIGHT 32
+#endif
 
 /*
- * END from internal.h
+ * The DAG may be split into DAG_SHARDS contiguous ranges of shard_pages
+ * pages, each on its own port so each can be linked to its own DDR/HBM
+ * bank (v++ --sp krnl_ethash_1.dag1:DDR[1] ...). Page indices are uniform,
+ * so every bank serves an equal share of the reads and the aggregate
+ * bandwidth scales with the number of banks. Shards beyond the first are
+ * the trailing kernel arguments; the host counts them from the argument
+ * count.
  */
-
-/*
- * END code from all headers
- */
-
-/*
- * BEGIN from sha3.c
- */
-
-/******** The Keccak-f[1600] permutation ********/
-
-/*** Constants. ***/
-constant const uchar rho[24] = \
-		{ 1,  3,   6, 10, 15, 21,
-	28, 36, 45, 55,  2, 14,
-	27, 41, 56,  8, 25, 43,
-	62, 18, 39, 61, 20, 44};
-constant const uchar pi[24] = \
-		{10,  7, 11, 17, 18, 3,
-	5, 16,  8, 21, 24, 4,
-	15, 23, 19, 13, 12, 2,
-	20, 14, 22,  9, 6,  1};
-constant const ulong RC[24] = \
-		{1ULL, 0x8082ULL, 0x800000000000808aULL, 0x8000000080008000ULL,
-	0x808bULL, 0x80000001ULL, 0x8000000080008081ULL, 0x8000000000008009ULL,
-	0x8aULL, 0x88ULL, 0x80008009ULL, 0x8000000aULL,
-	0x8000808bULL, 0x800000000000008bULL, 0x8000000000008089ULL, 0x8000000000008003ULL,
-	0x8000000000008002ULL, 0x8000000000000080ULL, 0x800aULL, 0x800000008000000aULL,
-	0x8000000080008081ULL, 0x8000000000008080ULL, 0x80000001ULL, 0x8000000080008008ULL};
-
-/*** Helper macros to unroll the permutation. ***/
-#define rol(x, s) (((x) << s) | ((x) >> (64 - s)))
-#define REPEAT6(e) e e e e e e
-#define REPEAT24(e) REPEAT6(e e e e)
-#define REPEAT5(e) e e e e e
-#define FOR5(v, s, e) \
-		v = 0;            \
-		REPEAT5(e; v += s;)
-
-/*** Keccak-f[1600] ***/
-void keccakf(void* state) {
-	ulong* a = (ulong*)state;
-	ulong b[5] = {0};
-	ulong t = 0;
-	uchar x, y;
-
-	for (int i = 0; i < 24; i++) {
-		// Theta
-		FOR5(x, 1,
-				b[x] = 0;
-		FOR5(y, 5,
-				b[x] ^= a[x + y]; ))
-        		 FOR5(x, 1,
-        				 FOR5(y, 5,
-        						 a[y + x] ^= b[(x + 4) % 5] ^ rol(b[(x + 1) % 5], 1); ))
-								 // Rho and pi
-								 t = a[1];
-		x = 0;
-		REPEAT24(b[0] = a[pi[x]];
-		a[pi[x]] = rol(t, rho[x]);
-		t = b[0];
-		x++; )
-		// Chi
-		FOR5(y,
-				5,
-				FOR5(x, 1,
-						b[x] = a[y + x];)
-						FOR5(x, 1,
-								a[y + x] = b[x] ^ ((~b[(x + 1) % 5]) & b[(x + 2) % 5]); ))
-								// Iota
-								a[0] ^= RC[i];
+#ifndef DAG_SHARDS
+#define DAG_SHARDS 1
+#endif
+#if DAG_SHARDS < 1 || DAG_SHARDS > 4
+#error "DAG_SHARDS must be between 1 and 4"
+#endif
+
+pipe ulong8 p_seed __attribute__((xcl_reqd_pipe_depth(2 * DAG_IN_FLIGHT)));
+pipe ulong8 p_final_seed __attribute__((xcl_reqd_pipe_depth(2 * DAG_IN_FLIGHT)));
+pipe uint8 p_cmix __attribute__((xcl_reqd_pipe_depth(2 * DAG_IN_FLIGHT)));
+pipe uint p_group __attribute__((xcl_reqd_pipe_depth(4)));
+pipe uint p_final_group __attribute__((xcl_reqd_pipe_depth(4)));
+
+static void seed_stage(
+		const global hash32_t* header_hash,
+		volatile const global ulong* cancel,
+		const ulong generation,
+		const ulong start_nonce,
+		const uint count,
+		const uint stride)
+{
+	ulong header[4];
+	for (unsigned i = 0; i < 4; i++) {
+		header[i] = header_hash->double_words[i];
 	}
-}
-
-/******** The FIPS202-defined functions. ********/
-
-/*** Some helper macros. ***/
 
-#define _(S) do { S } while (0)
-#define FOR(i, ST, L, S) \
-		_(for (size_t i = 0; i < L; i += ST) { S; })
-#define mkapply_ds(NAME, S)                                          \
-		static inline void NAME(uchar* dst,                              \
-				const uchar* src,                        \
-				size_t len) {                              \
-	FOR(i, 1, len, S);                                               \
-}
-#define mkapply_sd(NAME, S)                                          \
-		static inline void NAME(const uchar* src,                        \
-				uchar* dst,                              \
-				size_t len) {                              \
-	FOR(i, 1, len, S);                                               \
+	for (uint base = 0; base < count; base += DAG_IN_FLIGHT) {
+		// one uncached read a group; the host writes it while we run
+		if (*cancel > generation) {
+			break;
+		}
+		const uint group = count - base < DAG_IN_FLIGHT ? count - base : DAG_IN_FLIGHT;
+		write_pipe_block(p_group, &group);
+
+		__attribute__((xcl_pipeline_loop(1)))
+		for (uint j = 0; j != group; ++j) {
+			ulong in[5];
+			for (unsigned w = 0; w < 4; w++) {
+				in[w] = header[w];
+			}
+			in[4] = start_nonce + (ulong) (base + j) * stride;
+			word512_t seed;
+			SHA3_512_40(seed.double_words, in);
+			write_pipe_block(p_seed, &seed.v);
+		}
+	}
+	const uint end = 0;
+	write_pipe_block(p_group, &end);
 }
 
-mkapply_ds(xorin, dst[i] ^= src[i])  // xorin
-mkapply_sd(setout, dst[i] = src[i])  // setout
+static void dag_stage(
+		const global ulong8* dag0, // dag, MIX_NODES 512-bit beats per page
+		const global ulong8* dag1,
+		const global ulong8* dag2,
+		const global ulong8* dag3,
+		const uint num_full_pages,
+		const uint shard_pages)
+{
+	word512_t seed[DAG_IN_FLIGHT];
+	uint mix[DAG_IN_FLIGHT][MIX_WORDS] __attribute__((xcl_array_partition(complete, 2)));
+
+	for (;;) {
+		uint group;
+		read_pipe_block(p_group, &group);
+		write_pipe_block(p_final_group, &group);
+		if (!group) {
+			break;
+		}
 
-#define P keccakf
-#define Plen 200
+		for (uint j = 0; j != group; ++j) {
+			read_pipe_block(p_seed, &seed[j].v);
+			ethash_mix_init(mix[j], seed[j].words);
+		}
 
-// Fold P*F over the full blocks of an input.
-#define foldP(I, L, F) \
-		while (L >= rate) {  \
-			F(a, I, rate);     \
-			P(a);              \
-			I += rate;         \
-			L -= rate;         \
+		for (unsigned i = 0; i != ACCESSES; ++i) {
+			// No dependence between iterations, but a 128-byte page is
+			// MIX_NODES beats of the 512-bit port, the widest there is, so
+			// a port serves one page every MIX_NODES cycles.
+			__attribute__((xcl_pipeline_loop(MIX_NODES)))
+			for (uint j = 0; j != group; ++j) {
+				const uint index = ethash_mix_index(seed[j].words[0], mix[j], i) % ethash_full_pages(num_full_pages);
+				// every beat of the page from the one port that holds it
+				uint shard = 0;
+				uint page = index;
+				for (uint k = 1; k < DAG_SHARDS; ++k) {
+					if (page >= shard_pages) {
+						page -= shard_pages;
+						shard = k;
+					}
+				}
+				const global ulong8* dag = shard == 0 ? dag0 : shard == 1 ? dag1 : shard == 2 ? dag2 : dag3;
+				uint words[MIX_WORDS];
+				for (unsigned n = 0; n != MIX_NODES; ++n) {
+					word512_t beat;
+					beat.v = dag[MIX_NODES * page + n];
+					for (unsigned w = 0; w != NODE_WORDS; ++w) {
+						words[n * NODE_WORDS + w] = beat.words[w];
+					}
+				}
+				ethash_mix_page(mix[j], words);
+			}
 		}
 
-/** The sponge-based hash construction. **/
-int hash(uchar* out, size_t outlen,
-		const uchar* in, size_t inlen,
-		size_t rate, uchar delim) {
-	uchar a[Plen] = {0};
-	// Absorb input.
-	foldP(in, inlen, xorin);
-	// Xor in the DS and pad frame.
-	a[inlen] ^= delim;
-	a[rate - 1] ^= 0x80;
-	// Xor in the last block.
-	xorin(a, in, inlen);
-	// Apply P
-	P(a);
-	// Squeeze output.
-	foldP(out, outlen, setout);
-	setout(a, out, outlen);
-	//memset(a, 0, 200);
-	for (int i = 0; i < 200; i++) {
-		a[i] = 0;
+		// compress mix (length reduced from 128 to 32 bytes)
+		for (uint j = 0; j != group; ++j) {
+			word256_t cmix;
+			ethash_mix_compress(cmix.words, mix[j]);
+			write_pipe_block(p_final_seed, &seed[j].v);
+			write_pipe_block(p_cmix, &cmix.v);
+		}
 	}
-	return 0;
 }
 
-#define defsha3(bits)                                             \
-		int sha3_##bits(uchar* out, size_t outlen,                    \
-				const uchar* in, size_t inlen) {              \
-	if (outlen > (bits/8)) {                                      \
-		return -1;                                                  \
-	}                                                             \
-	return hash(out, outlen, in, inlen, 200 - (bits / 4), 0x01);  \
-}
-
-/*** FIPS202 SHA3 FOFs ***/
-defsha3(256)
-defsha3(512)
-
-/*
- * END from sha3.c
- */
-
-#define DAG_SIZE 1073739904U
-
-typedef union
-{
-	uchar bytes[32 / sizeof(uchar)];
-	uint words[32 / sizeof(uint)];
-	ulong double_words[32 / sizeof(ulong)];
-} hash32_t;
-
-typedef union
-{
-	uchar bytes[NODE_WORDS * 4];
-	uint words[NODE_WORDS];
-	ulong double_words[NODE_WORDS / 2];
-} node64_t;
-
-kernel __attribute__((reqd_work_group_size(1, 1, 1)))
-void krnl_ethash(
-		global hash32_t* ret_mix,
-		global hash32_t* ret_hash, // s+mix
-		global node64_t* full_nodes, // dag
-		const global hash32_t* header_hash,
-		const uint nonce)
+static void final_stage(
+		global search_results_t* results,
+		const global hash32_t* boundary,
+		const ulong start_nonce,
+		const uint stride)
 {
-	node64_t s_mix[MIX_NODES + 1];
-	hash32_t hash;
-	//memcpy(s_mix[0].bytes, header_hash, 32);
-	for (int i = 0; i < 32/4; i++) {
-		s_mix[0].words[i] = header_hash->words[i];
-	}
-
-	s_mix[0].double_words[4] = nonce;
-
-	// compute sha3-512 hash and replicate across mix
-	SHA3_512(s_mix->bytes, s_mix->bytes, 40);
-
-	node64_t* mix = s_mix + 1;
-	for (unsigned w = 0; w != MIX_WORDS; ++w) {
-		mix->words[w] = s_mix[0].words[w % NODE_WORDS];
+	hash32_t target;
+	for (unsigned i = 0; i < 32/4; i++) {
+		target.words[i] = boundary->words[i];
 	}
 
-	unsigned const full_size = (unsigned) DAG_SIZE;
-	unsigned const num_full_pages = (unsigned) (full_size / MIX_BYTES);
-
-	uint index;
-	node64_t dag_node;
-	for (unsigned i = 0; i != ACCESSES; ++i) {
-		index = ((s_mix->words[0] ^ i) * FNV_PRIME ^ mix->words[i % MIX_WORDS]) % num_full_pages;
-
-		for (unsigned n = 0; n != MIX_NODES; ++n) {
-			dag_node = full_nodes[MIX_NODES * index + n];
-
-			for (unsigned w = 0; w != NODE_WORDS; ++w) {
-				mix[n].words[w] = fnv_hash(mix[n].words[w], dag_node.words[w]);
+	uint found = 0;
+	uint hashed = 0;
+	for (;;) {
+		uint group;
+		read_pipe_block(p_final_group, &group);
+		if (!group) {
+			break;
+		}
+		__attribute__((xcl_pipeline_loop(1)))
+		for (uint i = hashed; i != hashed + group; ++i) {
+			word512_t seed;
+			word256_t cmix;
+			read_pipe_block(p_final_seed, &seed.v);
+			read_pipe_block(p_cmix, &cmix.v);
+
+			// final Keccak hash, Keccak-256(s + compressed_mix)
+			ulong in[12];
+			for (unsigned w = 0; w < 8; w++) {
+				in[w] = seed.double_words[w];
+			}
+			for (unsigned w = 0; w < 4; w++) {
+				in[8 + w] = cmix.double_words[w];
+			}
+			hash32_t hash;
+			SHA3_256_96(hash.double_words, in);
+
+			if (check_difficulty(&hash, &target)) {
+				if (found < SEARCH_SLOTS) {
+					global solution_t* slot = &results->slots[found];
+					slot->nonce = start_nonce + (ulong) i * stride;
+					for (unsigned w = 0; w < 4; w++) {
+						slot->mix.double_words[w] = cmix.double_words[w];
+						slot->hash.double_words[w] = hash.double_words[w];
+					}
+				}
+				++found;
 			}
 		}
+		hashed += group;
 	}
+	results->count = found;
+	results->hashed = hashed;
+}
 
-	// compress mix (length reduced from 128 to 32 bytes)
-	for (unsigned w = 0; w != MIX_WORDS; w += 4) {
-		uint reduction = mix->words[w + 0];
-		reduction = reduction * FNV_PRIME ^ mix->words[w + 1];
-		reduction = reduction * FNV_PRIME ^ mix->words[w + 2];
-		reduction = reduction * FNV_PRIME ^ mix->words[w + 3];
-		mix->words[w / 4] = reduction;
-	}
-
-	//memcpy(ret_mix, mix->bytes, 32);
-	for (unsigned i = 0; i < 32/4; i++) {
-		ret_mix->words[i] = mix->words[i];
-	}
-	// final Keccak hash
-	SHA3_256(hash.bytes, s_mix->bytes, 64 + 32); // Keccak-256(s + compressed_mix)
-	// copy from local mem to global
-	for (unsigned i = 0; i < 32/4; i++) {
-		ret_hash->words[i] = hash.words[i];
-	}
+kernel __attribute__((reqd_work_group_size(1, 1, 1)))
+__attribute__((xcl_dataflow))
+void krnl_ethash(
+		global search_results_t* results,
+		const global ulong8* dag0, // dag (first shard), 512-bit port
+		const global hash32_t* header_hash,
+		const global hash32_t* boundary,
+		const ulong start_nonce,
+		const uint count,
+		const uint stride, // compute units interleave: CU k starts at start_nonce + k, stride = #CUs
+		const uint num_full_pages, // full_size / MIX_BYTES for the current epoch
+		const uint shard_pages, // pages per DAG shard, ignored with one shard
+		volatile const global ulong* cancel, // abort word, raised by the host for stale work
+		const ulong generation // of the batch's work; it stops once *cancel exceeds it
+#if DAG_SHARDS > 1
+		, const global ulong8* dag1
+#endif
+#if DAG_SHARDS > 2
+		, const global ulong8* dag2
+#endif
+#if DAG_SHARDS > 3
+		, const global ulong8* dag3
+#endif
+		)
+{
+#if DAG_SHARDS < 2
+	const global ulong8* dag1 = dag0;
+#endif
+#if DAG_SHARDS < 3
+	const global ulong8* dag2 = dag0;
+#endif
+#if DAG_SHARDS < 4
+	const global ulong8* dag3 = dag0;
+#endif
+	seed_stage(header_hash, cancel, generation, start_nonce, count, stride);
+	dag_stage(dag0, dag1, dag2, dag3, num_full_pages, shard_pages);
+	final_stage(results, boundary, start_nonce, stride);
 }
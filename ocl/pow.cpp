@@ -41,10 +41,24 @@ THIS COPYRIGHT NOTICE AND DISCLAIMER MUST BE RETAINED AS PART OF THIS FILE AT
 ALL TIMES.
 
 *******************************************************************************/
+#include <errno.h>
+#include <getopt.h>
+#include <poll.h>
 #include <stdlib.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
 #include <fstream>
 #include <iostream>
-#include "pow.h"
+#include <sstream>
+#include <thread>
+#include <string.h>
+#include "backend.h"
+#include "scheduler.h"
+#include "telemetry.h"
+#include "epoch.h"
+#include "stratum.h"
 
 static const int DATA_SIZE = 4096;
 
@@ -96,132 +110,514 @@ static std::string bytesToHexString(uint8_t const* bytes, unsigned size)
 	return str;
 }
 
+// Batches are sized to take about BATCH_SECONDS on whichever unit runs them,
+// so fast and slow units report back at the same pace.
+static const double BATCH_SECONDS = 0.25;
+static const uint32_t INITIAL_BATCH = 1U << 20;
+static const uint32_t BATCH_GRANULE = 4096;
+static const uint32_t MAX_BATCH = 1U << 26;
+
+// nonces partitioned between the units at a time when mining without a limit
+static const uint64_t ROUND_NONCES = 1ULL << 32;
+
+// interval of the stats line and of the metrics dump
+static const double STATS_SECONDS = 10;
+
+// a DAG whose file turned out corrupt is removed, so a second attempt
+// generates it afresh
+static const unsigned DAG_ATTEMPTS = 2;
+
+// Comma-separated units: "cpu" or "cpu:<threads>" for the CPU backend, any
+// other entry is an xclbin loaded onto every Xilinx accelerator found.
+static std::vector<std::unique_ptr<miner_backend>> open_backends(const std::string& specs)
+{
+    std::vector<std::unique_ptr<miner_backend>> backends;
+    std::string error;
+    std::istringstream list(specs);
+    std::string spec;
+    while (std::getline(list, spec, ',')) {
+        if (spec.compare(0, 3, "cpu") == 0) {
+            // cpu[:threads[:interleave|sharded|replicate]]
+            std::istringstream fields(spec);
+            std::string field, threads, placement;
+            std::getline(fields, field, ':');
+            std::getline(fields, threads, ':');
+            std::getline(fields, placement, ':');
+            cpu_dag_placement where = CPU_DAG_INTERLEAVE;
+            if (placement == "sharded")
+                where = CPU_DAG_SHARDED;
+            else if (placement == "replicate")
+                where = CPU_DAG_REPLICATE;
+            else if (!placement.empty() && placement != "interleave")
+                std::cout << "warning: unknown DAG placement " << placement << ", interleaving" << std::endl;
+            std::unique_ptr<miner_backend> backend = make_cpu_backend((unsigned) strtoul(threads.c_str(), NULL, 10), where);
+            if (backend->init(error))
+                backends.push_back(std::move(backend));
+            else
+                std::cout << "warning: " << error << std::endl;
+            continue;
+        }
+        std::cout << "Loading: '" << spec << "'\n";
+        unsigned devices = ocl_device_count();
+        if (!devices)
+            std::cout << "warning: no Xilinx accelerator found" << std::endl;
+        for (unsigned d = 0; d != devices; ++d) {
+            std::unique_ptr<miner_backend> backend = make_ocl_backend(spec, d);
+            if (backend->init(error))
+                backends.push_back(std::move(backend));
+            else
+                std::cout << "warning: " << error << std::endl;
+        }
+    }
+    if (backends.empty()) {
+        // same driver, same results, just slower
+        std::cout << "warning: no device could be opened, mining on the CPU instead" << std::endl;
+        std::unique_ptr<miner_backend> backend = make_cpu_backend(0, CPU_DAG_INTERLEAVE);
+        if (backend->init(error))
+            backends.push_back(std::move(backend));
+        else
+            std::cout << "Error: " << error << std::endl;
+    }
+    return backends;
+}
+
+// State shared by the unit threads of one run.
+struct mining_run
+{
+    epoch_manager* epochs;
+    work_feed* feed;
+    uint64_t first_generation;      // work the units start on, not timed
+    nonce_scheduler* scheduler;
+    telemetry* stats;
+    stratum_client* pool = NULL;    // where solutions go, when there is one
+    std::mutex mutex;
+    std::vector<miner_backend*> units;  // told about new work; emptied before they go
+    unsigned long solutions = 0, stale = 0, mismatches = 0;
+    std::atomic<bool> failed{false};    // set by any unit thread, read after the joins
+};
+
+// Makes new work current and cuts short the batches still on older work, so
+// each unit takes it up with its next submit instead of behind stale batches.
+static void new_work(mining_run& run, const uint8_t header[32], const uint8_t* boundary, const uint32_t* epoch,
+        std::chrono::steady_clock::time_point received)
+{
+    uint64_t generation = run.feed->update(header, boundary, epoch, received);
+    std::lock_guard<std::mutex> lock(run.mutex);
+    for (unsigned u = 0; u != run.units.size(); ++u)
+        run.units[u]->cancel(generation);
+}
+
+// Checks every hit against the host's copy of the DAG, so any backend is held
+// to c/ethash.c. Under XCL_EMULATION_MODE=sw_emu the kernel runs on the CPU,
+// which exercises the whole pipeline without hardware.
+static void report(mining_run& run, unsigned unit, const epoch_dag& dag, const search_result& result)
+{
+    const work_package& work = result.request.work;
+    bool is_stale = work.generation != run.feed->get().generation;
+    std::lock_guard<std::mutex> lock(run.mutex);
+    for (unsigned i = 0; i != result.solutions.size(); i++) {
+        const ethash_solution &sol = result.solutions[i];
+        ethash_return_value expect;
+        ethash_hash(&expect, (node const *) dag.ctx.dag, &dag.ctx.params, work.header, sol.nonce);
+        bool ok = memcmp(expect.mix_hash, sol.value.mix_hash, 32) == 0
+                && memcmp(expect.result, sol.value.result, 32) == 0
+                && ethash_check_difficulty(expect.result, work.boundary);
+        run.mismatches += !ok;
+        run.stats->record_solution(unit, is_stale, !ok);
+        // stale ones too: the pool knows whether it still takes the header
+        bool sent = ok && run.pool && run.pool->submit(sol.nonce, work.header, sol.value.mix_hash);
+        std::cout << "nonce: " << sol.nonce << (is_stale ? " (stale)" : "") << (ok ? "" : " MISMATCH")
+            << (ok && run.pool && !sent ? " (not submitted, disconnected)" : "") << std::endl;
+        std::cout << "mix: " << bytesToHexString(sol.value.mix_hash, 32).c_str() << std::endl;
+        std::cout << "hsh: " << bytesToHexString(sol.value.result, 32).c_str() << std::endl;
+    }
+    if (result.hits > result.solutions.size()) {
+        std::cout << "warning: " << result.hits - result.solutions.size() << " solutions dropped from the batch" << std::endl;
+    }
+    run.solutions += result.hits;
+    run.stale += is_stale ? result.hits : 0;
+}
+
+// Run through every backend before it mines: with an all-ones boundary each
+// nonce is a hit, so the device's mix and hash come back for all of them and
+// must match the host DAG, and on epoch 0 the published block 22 result.
+static bool check_backend(const epoch_dag& dag, miner_backend& backend, std::string& error)
+{
+    static const uint64_t BLOCK_22_NONCE = 0x495732e0ed7a801cULL;
+    search_request request;
+    memcpy(request.work.header, hexStringToBytes("372eca2454ead349c3df0ab5d00b0b706b23e49d469387db91811cee0358fc6d").data(), 32);
+    memset(request.work.boundary, 0xff, 32);
+    request.work.epoch = dag.ctx.epoch;
+    request.work.generation = UINT64_MAX;   // never cancelled
+    request.start_nonce = BLOCK_22_NONCE;
+    request.stride = 1;
+    request.count = BATCH_SOLUTIONS;
+    backend.submit(request);
+    search_result result;
+    if (!backend.poll(result, true) || result.hits != request.count || result.solutions.size() != request.count) {
+        error = "known-answer batch returned " + std::to_string(result.hits) + " of " + std::to_string(request.count) + " hits";
+        return false;
+    }
+    for (unsigned i = 0; i != result.solutions.size(); ++i) {
+        const ethash_solution& sol = result.solutions[i];
+        ethash_return_value expect;
+        ethash_hash(&expect, (node const *) dag.ctx.dag, &dag.ctx.params, request.work.header, sol.nonce);
+        if (sol.nonce - request.start_nonce >= request.count
+                || memcmp(expect.mix_hash, sol.value.mix_hash, 32) != 0
+                || memcmp(expect.result, sol.value.result, 32) != 0) {
+            error = "nonce " + std::to_string(sol.nonce) + " differs from the host DAG";
+            return false;
+        }
+        if (dag.ctx.epoch == 0 && sol.nonce == BLOCK_22_NONCE
+                && (bytesToHexString(sol.value.mix_hash, 32) != "2f74cdeb198af0b9abe65d22d372e22fb2d474371774a9583c1cc427a07939f5"
+                || bytesToHexString(sol.value.result, 32) != "00000b184f1fdd88bfd94c86c39e65db0c36144d5e43f745f722196e730cb614")) {
+            error = "block 22 differs from the published result";
+            return false;
+        }
+    }
+    return true;
+}
+
+// Makes dag the unit's DAG and runs the known-answer batch on it; only with
+// nothing in flight.
+static bool load_unit(mining_run& run, unsigned unit, miner_backend& backend, const epoch_dag& dag, std::string& error)
+{
+    auto start = std::chrono::steady_clock::now();
+    bool loaded = backend.load_epoch(dag.ctx, error);
+    run.stats->record_epoch_load(unit, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    return loaded && check_backend(dag, backend, error);
+}
+
+// One thread per unit: keep its pipeline full with batches from the
+// scheduler and feed back the rate it actually sustains. When work for
+// another epoch arrives the unit drains its batches, takes the new DAG
+// (normally prepared in the background by then) and carries on. The first
+// batch back for each new work package times its receipt to first hash.
+static void mine(mining_run& run, unsigned unit, miner_backend& backend, std::shared_ptr<const epoch_dag> dag)
+{
+    uint64_t timed = run.first_generation;
+    unsigned in_flight = 0;
+    bool drained = false;
+    auto mark = std::chrono::steady_clock::now();
+    for (;;) {
+        uint32_t switch_to = dag->ctx.epoch;
+        while (!drained && in_flight < backend.max_in_flight()) {
+            work_package work = run.feed->get();
+            if (work.epoch != dag->ctx.epoch) {
+                switch_to = work.epoch;
+                break;
+            }
+            uint32_t max_count = run.scheduler->batch_size(unit, BATCH_SECONDS, INITIAL_BATCH, BATCH_GRANULE, MAX_BATCH);
+            nonce_range range;
+            if (!run.scheduler->next(unit, max_count, range)) {
+                drained = true;
+                break;
+            }
+            if (!in_flight)
+                mark = std::chrono::steady_clock::now(); // idle time is not the unit's
+            search_request request;
+            request.work = work;
+            request.start_nonce = range.begin;
+            request.stride = 1;
+            request.count = (uint32_t) (range.end - range.begin);
+            backend.submit(request);
+            ++in_flight;
+        }
+        if (!in_flight && switch_to != dag->ctx.epoch) {
+            std::string error;
+            auto start = std::chrono::steady_clock::now();
+            std::shared_ptr<const epoch_dag> next;
+            bool loaded = false;
+            for (unsigned attempt = 0; !loaded && attempt != DAG_ATTEMPTS; ++attempt) {
+                if (attempt)
+                    std::cout << "warning: " << backend.name() << ": " << error << std::endl;
+                next = run.epochs->acquire(switch_to, error);
+                loaded = next && load_unit(run, unit, backend, *next, error);
+                if (!next || !next->failed())
+                    break;  // only a failed DAG is worth another attempt
+            }
+            if (!loaded) {
+                std::cout << "Error: " << backend.name() << ": " << error << std::endl;
+                run.failed = true;
+                return;
+            }
+            dag = next; // the old DAG is unmapped once every unit has let go
+            run.stats->record_dag_prepare(dag->ctx.epoch, dag->prepare_seconds);
+            std::cout << backend.name() << ": switched to epoch " << dag->ctx.epoch << " in "
+                << std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() << " s" << std::endl;
+            continue;
+        }
+        search_result result;
+        if (!in_flight || !backend.poll(result, true))
+            break;
+        --in_flight;
+        auto now = std::chrono::steady_clock::now();
+        run.scheduler->record(unit, result.hashed, std::chrono::duration<double>(now - mark).count());
+        mark = now;
+        const work_package& work = result.request.work;
+        if (work.generation > timed && result.hashed) {
+            timed = work.generation;
+            run.stats->record_job_start(unit, std::chrono::duration<double>(result.started - work.received).count());
+        }
+        run.stats->record_batch(unit, result);
+        run.stats->record_threads(unit, backend.thread_hashes());
+        report(run, unit, *dag, result);
+    }
+}
+
+// One line of new work: a 64-digit header, then an optional 64-digit
+// boundary and an optional block number, in either order.
+static void work_line(mining_run& run, const std::string& line, std::chrono::steady_clock::time_point received)
+{
+    std::istringstream fields(line);
+    std::string header, field, boundary;
+    fields >> header;
+    bool valid = header.size() == 64;
+    bool has_epoch = false;
+    uint32_t epoch = 0;
+    while (valid && fields >> field) {
+        char* end;
+        unsigned long block = strtoul(field.c_str(), &end, 10);
+        if (field.size() == 64 && boundary.empty()) {
+            boundary = field;
+        } else if (*end == 0 && !has_epoch) {
+            has_epoch = true;
+            epoch = (uint32_t) (block / ETHASH_EPOCH_LENGTH);
+        } else {
+            valid = false;
+        }
+    }
+    if (!valid) {
+        std::cout << "ignoring work line: " << line << std::endl;
+        return;
+    }
+    new_work(run, hexStringToBytes(header.c_str()).data(),
+            boundary.empty() ? NULL : hexStringToBytes(boundary.c_str()).data(),
+            has_epoch ? &epoch : NULL, received);
+}
+
+// Work lines from stdin until it ends or stop_fd becomes readable; polled
+// rather than a blocking getline so main can join it before run goes away.
+static void read_work(mining_run& run, int stop_fd)
+{
+    std::string pending;
+    for (;;) {
+        struct pollfd fds[2] = {{STDIN_FILENO, POLLIN, 0}, {stop_fd, POLLIN, 0}};
+        if (poll(fds, 2, -1) < 0) {
+            if (errno == EINTR)
+                continue;
+            return;
+        }
+        if (fds[1].revents)
+            return;
+        char buffer[4096];
+        ssize_t n = read(STDIN_FILENO, buffer, sizeof(buffer));
+        if (n < 0 && errno == EINTR)
+            continue;
+        if (n <= 0)
+            return;
+        auto const received = std::chrono::steady_clock::now();
+        pending.append(buffer, n);
+        size_t end;
+        while ((end = pending.find('\n')) != std::string::npos) {
+            work_line(run, pending.substr(0, end), received);
+            pending.erase(0, end + 1);
+        }
+    }
+}
+
 int main(int argc, char* argv[]) {
 
-    //TARGET_DEVICE macro needs to be passed from gcc command line
-    if(argc != 2) {
-		std::cout << "Usage: " << argv[0] <<" <xclbin>" << std::endl;
+    // --no-verify trusts the DAG files already in dag_dir: they are used as
+    // they are read in, instead of once all of each has been checksummed
+    static const struct option long_options[] = {
+        {"no-verify", no_argument, NULL, 'n'},
+        {NULL, 0, NULL, 0}
+    };
+    int dag_flags = 0;
+    bool usage = false;
+    int opt;
+    while ((opt = getopt_long(argc, argv, "+", long_options, NULL)) != -1) {
+        if (opt == 'n')
+            dag_flags |= ETHASH_DAG_NO_VERIFY;
+        else
+            usage = true;
+    }
+    char** const args = argv + optind;
+    int const num_args = argc - optind;
+
+    if(usage || num_args < 1 || num_args > 6) {
+		std::cout << "Usage: " << argv[0] <<" [--no-verify] <xclbin|cpu[:threads[:interleave|sharded|replicate]]>[,...] [block_number] [dag_dir] [mega_nonces] [metrics] [pool]" << std::endl;
+		std::cout << "  searches mega_nonces * 2^20 nonces over all units, 0 mines until killed;" << std::endl;
+		std::cout << "  new work is read from stdin as lines of \"<header hex> [boundary hex] [block_number]\";" << std::endl;
+		std::cout << "  a block of a new epoch switches to its DAG, prepared ahead in dag_dir;" << std::endl;
+		std::cout << "  metrics is a file, or unix:<socket path>, that serves Prometheus text;" << std::endl;
+		std::cout << "  pool is a stratum (eth-proxy) server, [login@]unix:<socket path> or [login@]<host>:<port>," << std::endl;
+		std::cout << "  that work then comes from and solutions go to;" << std::endl;
+		std::cout << "  --no-verify skips the checksum of DAG files already in dag_dir" << std::endl;
 		return EXIT_FAILURE;
 	}
 
-    char* xclbinFilename = argv[1];
-    
-    size_t size_dag = 1073739904U;
-    size_t size_hsh = 32U;
-    
-    // Creates a vector of DATA_SIZE elements with an initial value of 10 and 32
-    // using customized allocator for getting buffer alignment to 4k boundary
-    
-    std::vector<cl::Device> devices;
-    cl::Device device;
-    std::vector<cl::Platform> platforms;
-    bool found_device = false;
-
-    //traversing all Platforms To find Xilinx Platform and targeted
-    //Device in Xilinx Platform
-    cl::Platform::get(&platforms);
-    for(size_t i = 0; (i < platforms.size() ) & (found_device == false) ;i++){
-        cl::Platform platform = platforms[i];
-        std::string platformName = platform.getInfo<CL_PLATFORM_NAME>();
-        if ( platformName == "Xilinx"){
-            devices.clear();
-            platform.getDevices(CL_DEVICE_TYPE_ACCELERATOR, &devices);
-	    if (devices.size()){
-		    device = devices[0];
-		    found_device = true;
-		    break;
-	    }
+    uint32_t block_number = num_args >= 2 ? (uint32_t) strtoul(args[1], NULL, 10) : 0;
+    const char* dag_dir = num_args >= 3 ? args[2] : ".";
+    uint64_t mega_nonces = num_args >= 4 ? strtoull(args[3], NULL, 10) : 16;
+    std::string metrics = num_args >= 5 ? args[4] : "";
+    std::string pool_address = num_args >= 6 ? args[5] : "";
+
+    std::vector<std::unique_ptr<miner_backend>> backends = open_backends(args[0]);
+    if (backends.empty())
+        return EXIT_FAILURE;
+    telemetry stats((unsigned) backends.size());
+    for (unsigned u = 0; u != backends.size(); ++u) {
+        std::cout << "unit " << u << ": " << backends[u]->name() << ", " << backends[u]->compute_units() << " compute units" << std::endl;
+        stats.set_unit_name(u, backends[u]->name());
+    }
+
+    // the host implementation is the reference for every backend
+    char self_test_error[256];
+    if (ethash_self_test(1, self_test_error, sizeof(self_test_error)) != 0) {
+        std::cout << "Error: self test failed: " << self_test_error << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    // initial work; replaced at any time from stdin or, with a pool, by
+    // whatever it sends, the first job included
+    work_package initial;
+	memcpy(initial.header, hexStringToBytes("c5d2460186f7233c927e7db2dcc703c0e500b653ca82273b7bfad8045d85a470").data(), 32);
+	// init boundary, ~1 hit per 2^20 nonces
+	memcpy(initial.boundary, hexStringToBytes("00000fffffffffffffffffffffffffffffffffffffffffffffffffffffffffff").data(), 32);
+    initial.epoch = block_number / ETHASH_EPOCH_LENGTH;
+    initial.generation = 0;
+    initial.received = std::chrono::steady_clock::now();
+    work_feed feed(initial);
+    mining_run run;
+    run.feed = &feed;
+    run.stats = &stats;
+
+    std::string error;
+    std::unique_ptr<stratum_client> pool;
+    if (!pool_address.empty()) {
+        pool.reset(new stratum_client(pool_address,
+            [&run](const stratum_job& job) { new_work(run, job.header, job.boundary, &job.epoch, job.received); },
+            [&stats](bool accepted) { stats.record_share(accepted); }));
+        if (!pool->start(error)) {
+            std::cout << "Error: " << error << std::endl;
+            return EXIT_FAILURE;
         }
+        stratum_job job;
+        while (!pool->wait_job(job, STATS_SECONDS))
+            std::cout << "waiting for work from " << pool_address << std::endl;
+        run.pool = pool.get();
     }
-    if (found_device == false){
-       std::cout << "Error: Unable to find Target Device " 
-           << device.getInfo<CL_DEVICE_NAME>() << std::endl;
-       return EXIT_FAILURE; 
-    }
-
-    // Creating Context and Command Queue for selected device
-    cl::Context context(device);
-    cl::CommandQueue q(context, device, CL_QUEUE_PROFILING_ENABLE);
-
-    // Load xclbin 
-    std::cout << "Loading: '" << xclbinFilename << "'\n";
-    std::ifstream bin_file(xclbinFilename, std::ifstream::binary);
-    bin_file.seekg (0, bin_file.end);
-    unsigned nb = bin_file.tellg();
-    bin_file.seekg (0, bin_file.beg);
-    char *buf = new char [nb];
-    bin_file.read(buf, nb);
-    
-    // Creating Program from Binary File
-    cl::Program::Binaries bins;
-    bins.push_back({buf,nb});
-    devices.resize(1);
-    cl::Program program(context, devices, bins);
-    
-    // This call will get the kernel object from program. A kernel is an 
-    // OpenCL function that is executed on the FPGA. 
-    cl::Kernel krnl_pow(program,"krnl_ethash");
-    
-    // These commands will allocate memory on the Device. The cl::Buffer objects can
-    // be used to reference the memory locations on the device. 
-    cl::Buffer buf_res_mix(context, CL_MEM_WRITE_ONLY, size_hsh);
-    cl::Buffer buf_res_hsh(context, CL_MEM_WRITE_ONLY, size_hsh);
-    cl::Buffer buf_dag(context, CL_MEM_READ_ONLY, size_dag);
-    cl::Buffer buf_hdr(context, CL_MEM_READ_ONLY, size_hsh);
-    
-    //set the kernel Arguments
-    int narg=0;
-    krnl_pow.setArg(narg++, buf_res_mix);
-    krnl_pow.setArg(narg++, buf_res_hsh);
-    krnl_pow.setArg(narg++, buf_dag);
-    krnl_pow.setArg(narg++, buf_hdr);
-    krnl_pow.setArg(narg++, 0); //nonce=0
-
-    //We then need to map our OpenCL buffers to get the pointers
-    char *p_res_mix = (char *) q.enqueueMapBuffer (buf_res_mix , CL_TRUE , CL_MAP_WRITE , 0, size_hsh);
-    char *p_res_hsh = (char *) q.enqueueMapBuffer (buf_res_hsh , CL_TRUE , CL_MAP_WRITE , 0, size_hsh);
-    char *p_dag = (char *) q.enqueueMapBuffer (buf_dag , CL_TRUE , CL_MAP_READ , 0, size_dag);
-    char *p_hdr = (char *) q.enqueueMapBuffer (buf_hdr , CL_TRUE , CL_MAP_READ , 0, size_hsh);
-
-    // init dag
-	std::ifstream file("../dataset", std::ios::binary | std::ios::ate);
-	std::streamsize size = file.tellg();
-	file.seekg(0, std::ios::beg);
-	if (file.read(p_dag, size))
-	{
-		std::cout << "dag loaded\n";
-	} else {
-		std::cout << "failed to load dag\n";
-		std::cout << "error: only " << file.gcount() << " could be read\n";
-		std::cout << "eof: " << file.eof() << "\n";
-		std::cout << "fail: " << file.fail() << "\n";
-		std::cout << "bad: " << file.bad() << "\n";
-	}
-	// init header hash
-	memcpy(p_hdr, hexStringToBytes("c5d2460186f7233c927e7db2dcc703c0e500b653ca82273b7bfad8045d85a470").data(), 32);
+    run.first_generation = feed.get().generation;
 
-    // Data will be migrated to kernel space
-    q.enqueueMigrateMemObjects({buf_dag,buf_hdr},0/* 0 means from host*/);
+    // init dag: map the epoch's DAG file (generating and persisting it on a
+    // miss); backends use the mapping in place, and the next epoch's file is
+    // prepared in the background from here on
+    epoch_manager epochs(dag_dir, dag_flags);
+    run.epochs = &epochs;
+    auto start = std::chrono::steady_clock::now();
+    std::shared_ptr<const epoch_dag> dag;
+    for (unsigned attempt = 0; ; ++attempt) {
+        dag = epochs.acquire(feed.get().epoch, error);
+        if (!dag) {
+            std::cout << "Error: " << error << std::endl;
+            return EXIT_FAILURE;
+        }
 
-    //Launch the Kernel
-    q.enqueueTask(krnl_pow);
+        // every unit uploads the chunks as they are produced, all at once
+        std::vector<std::string> load_errors(backends.size());
+        std::vector<std::thread> loaders;
+        for (unsigned u = 0; u != backends.size(); ++u)
+            loaders.push_back(std::thread([&, u]() {
+                if (!load_unit(run, u, *backends[u], *dag, load_errors[u]) && load_errors[u].empty())
+                    load_errors[u] = "unable to load the DAG";
+            }));
+        for (unsigned u = 0; u != loaders.size(); ++u)
+            loaders[u].join();
+        bool const loaded = std::all_of(load_errors.begin(), load_errors.end(),
+                [](const std::string& e) { return e.empty(); });
+        if (loaded)
+            break;
+        bool const retry = attempt + 1 != DAG_ATTEMPTS && dag->failed();
+        for (unsigned u = 0; u != backends.size(); ++u) {
+            if (!load_errors[u].empty())
+                std::cout << (retry ? "warning: " : "Error: ") << backends[u]->name() << ": " << load_errors[u] << std::endl;
+        }
+        if (!retry)
+            return EXIT_FAILURE;
+    }
+    std::cout << "dag for epoch " << dag->ctx.epoch << " ready in " << (long) (dag->prepare_seconds * 1e3)
+        << " ms, on every unit in " << (long) (std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count() * 1e3) << " ms\n";
+    stats.record_dag_prepare(dag->ctx.epoch, dag->prepare_seconds);
+
+    // stdin is read until EOF, or until a byte on stop_reader after the units are done
+    int stop_reader[2];
+    if (pipe(stop_reader) != 0) {
+        std::cout << "Error: unable to create a pipe" << std::endl;
+        return EXIT_FAILURE;
+    }
+    std::thread reader(read_work, std::ref(run), stop_reader[0]);
 
-    // The result of the previous kernel execution will need to be retrieved in
-    // order to view the results. This call will transfer the data from FPGA to
-    // source_results vector
-    q.enqueueMigrateMemObjects({buf_res_mix,buf_res_hsh},CL_MIGRATE_MEM_OBJECT_HOST);
+    uint64_t limit = mega_nonces ? mega_nonces << 20 : UINT64_MAX;
+    nonce_scheduler scheduler((unsigned) backends.size(), 0, limit, ROUND_NONCES);
+    run.scheduler = &scheduler;
 
-    q.finish();
+    telemetry_reporter reporter(stats, STATS_SECONDS, metrics, [](const telemetry_sample& sample) {
+        for (unsigned u = 0; u != sample.units.size(); ++u) {
+            const unit_telemetry& unit = sample.units[u];
+            std::cout << "stats: " << unit.name << " " << unit.hashes_per_second / 1e6 << " MH/s, "
+                << unit.solutions << " solutions (" << unit.stale << " stale, " << unit.rejected << " rejected), "
+                << "kernel " << unit.device_seconds << " s, transfers " << unit.transfer_seconds << " s, "
+                << unit.dag_bytes_per_second / 1e9 << " GB/s of DAG, "
+                << unit.jobs << " new jobs, last started in " << unit.job_latency_seconds * 1e3 << " ms" << std::endl;
+        }
+    });
+    if (!reporter.start(error))
+        std::cout << "warning: metrics: " << error << std::endl;
 
-    //Print the result
-    std::cout << "mix: " << bytesToHexString((const uint8_t*)p_res_mix, 32).c_str() << std::endl;
-    std::cout << "hsh: " << bytesToHexString((const uint8_t*)p_res_hsh, 32).c_str() << std::endl;
+    for (unsigned u = 0; u != backends.size(); ++u)
+        run.units.push_back(backends[u].get());
+    auto mine_start = std::chrono::steady_clock::now();
+    std::vector<std::thread> units;
+    for (unsigned u = 0; u != backends.size(); ++u)
+        units.push_back(std::thread(mine, std::ref(run), u, std::ref(*backends[u]), dag));
+    dag.reset(); // held by the units only, so it is unmapped once they all move on
+    for (unsigned u = 0; u != units.size(); ++u)
+        units[u].join();
+    if (write(stop_reader[1], "", 1) != 1)
+        std::cout << "warning: unable to stop the work reader" << std::endl;
+    reader.join();
+    close(stop_reader[0]);
+    close(stop_reader[1]);
+    double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - mine_start).count();
 
-    q.enqueueUnmapMemObject(buf_res_mix , p_res_mix);
-    q.enqueueUnmapMemObject(buf_res_hsh , p_res_hsh);
-    q.enqueueUnmapMemObject(buf_dag , p_dag);
-    q.enqueueUnmapMemObject(buf_hdr , p_hdr);
-    q.finish();
+    uint64_t searched = 0;
+    for (unsigned u = 0; u != backends.size(); ++u) {
+        unit_stats stats = scheduler.stats(u);
+        searched += stats.hashes;
+        std::cout << backends[u]->name() << ": " << stats.hashes << " nonces in " << stats.batches << " batches, "
+            << stats.steals << " steals, " << (secs > 0 ? stats.hashes / secs / 1e6 : 0) << " MH/s" << std::endl;
+    }
+    std::cout << "searched " << searched << " nonces, "
+        << run.solutions << " solutions (" << run.stale << " stale), "
+        << (secs > 0 ? searched / secs / 1e6 : 0) << " MH/s" << std::endl;
+    if (pool) {
+        telemetry_sample const last = stats.sample();
+        std::cout << "pool accepted " << last.shares_accepted << " shares, rejected " << last.shares_rejected << std::endl;
+    }
+    pool.reset();
+    {
+        std::lock_guard<std::mutex> lock(run.mutex);
+        run.units.clear();
+    }
+    backends.clear();
 
+    if (run.failed)
+        return EXIT_FAILURE;
+    if (run.mismatches) {
+        std::cout << "Error: " << run.mismatches << " solutions do not match the host DAG" << std::endl;
+        return EXIT_FAILURE;
+    }
     return 0;
 }
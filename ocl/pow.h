@@ -52,20 +52,21 @@ ALL TIMES.
 
 #include <CL/cl2.hpp>
 
-//Customized buffer allocation for 4K boundary alignment
-template <typename T>
-struct aligned_allocator
+// Mirrors search_results_t in krnl_ethash.cl
+#define SEARCH_SLOTS 8
+
+struct solution
+{
+  cl_ulong nonce;
+  cl_ulong pad[3];
+  uint8_t mix[32];
+  uint8_t hash[32];
+};
+
+struct search_results
 {
-  using value_type = T;
-  T* allocate(std::size_t num)
-  {
-    void* ptr = nullptr;
-    if (posix_memalign(&ptr,4096,num*sizeof(T)))
-      throw std::bad_alloc();
-    return reinterpret_cast<T*>(ptr);
-  }
-  void deallocate(T* p, std::size_t num)
-  {
-    free(p);
-  }
+  cl_uint count;
+  cl_uint hashed;
+  cl_uint pad[6];
+  solution slots[SEARCH_SLOTS];
 };
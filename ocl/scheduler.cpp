@@ -0,0 +1,142 @@
+/*
+  This file is part of ethash.
+
+  ethash is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  ethash is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with ethash.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file scheduler.cpp
+* @date 2026
+*/
+
+#include <algorithm>
+#include "scheduler.h"
+
+// weight of the newest measurement in the smoothed rate
+static const double RATE_SMOOTHING = 0.3;
+
+// ranges smaller than this are taken whole rather than split
+static const uint64_t MIN_STEAL = 4096;
+
+nonce_scheduler::nonce_scheduler(unsigned units, uint64_t start, uint64_t limit, uint64_t round_size) :
+    ranges_(units), stats_(units), cursor_(start), limit_(limit), round_size_(round_size)
+{
+    for (unsigned i = 0; i != units; ++i) {
+        ranges_[i].begin = ranges_[i].end = start;
+        stats_[i] = unit_stats();
+    }
+}
+
+bool nonce_scheduler::next(unsigned unit, uint32_t max_count, nonce_range& batch)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    nonce_range& own = ranges_[unit];
+    while (own.begin == own.end) {
+        if (!steal(unit) && !open_round())
+            return false;
+    }
+    batch.begin = own.begin;
+    batch.end = own.begin + std::min<uint64_t>(max_count, own.end - own.begin);
+    own.begin = batch.end;
+    stats_[unit].batches++;
+    return true;
+}
+
+// Takes the upper half of the largest remaining range, whose owner keeps
+// working from the bottom of it undisturbed.
+bool nonce_scheduler::steal(unsigned unit)
+{
+    unsigned victim = unit;
+    uint64_t largest = 0;
+    for (unsigned i = 0; i != ranges_.size(); ++i) {
+        uint64_t left = ranges_[i].end - ranges_[i].begin;
+        if (left > largest) {
+            largest = left;
+            victim = i;
+        }
+    }
+    if (!largest)
+        return false;
+    nonce_range& from = ranges_[victim];
+    uint64_t const split = largest < MIN_STEAL ? from.begin : from.begin + largest / 2;
+    ranges_[unit].begin = split;
+    ranges_[unit].end = from.end;
+    from.end = split;
+    stats_[unit].steals++;
+    return true;
+}
+
+// Partitions the next round in proportion to the measured rates; units not
+// measured yet count as the average of those that are, or all equal.
+bool nonce_scheduler::open_round()
+{
+    if (cursor_ >= limit_)
+        return false;
+    uint64_t const size = std::min(round_size_, limit_ - cursor_);
+
+    double measured = 0;
+    unsigned num_measured = 0;
+    for (unsigned i = 0; i != stats_.size(); ++i) {
+        if (stats_[i].rate > 0) {
+            measured += stats_[i].rate;
+            num_measured++;
+        }
+    }
+    double const fallback = num_measured ? measured / num_measured : 1;
+    std::vector<double> weights(stats_.size());
+    double total = 0;
+    for (unsigned i = 0; i != stats_.size(); ++i) {
+        weights[i] = stats_[i].rate > 0 ? stats_[i].rate : fallback;
+        total += weights[i];
+    }
+
+    uint64_t begin = cursor_;
+    for (unsigned i = 0; i != ranges_.size(); ++i) {
+        uint64_t share = i + 1 == ranges_.size()
+                ? cursor_ + size - begin
+                : std::min<uint64_t>((uint64_t) (size * (weights[i] / total)), cursor_ + size - begin);
+        ranges_[i].begin = begin;
+        ranges_[i].end = begin + share;
+        begin += share;
+    }
+    cursor_ += size;
+    return true;
+}
+
+void nonce_scheduler::record(unsigned unit, uint64_t hashes, double seconds)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    unit_stats& stats = stats_[unit];
+    stats.hashes += hashes;
+    if (seconds <= 0)
+        return;
+    double const rate = hashes / seconds;
+    stats.rate = stats.rate > 0 ? stats.rate + RATE_SMOOTHING * (rate - stats.rate) : rate;
+}
+
+uint32_t nonce_scheduler::batch_size(unsigned unit, double target_seconds, uint32_t initial, uint32_t granule, uint32_t max_count) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    double const rate = stats_[unit].rate;
+    if (rate <= 0)
+        return initial;
+    double const want = rate * target_seconds;
+    uint64_t count = want >= max_count ? max_count : (uint64_t) want;
+    count -= count % granule;
+    return (uint32_t) std::max<uint64_t>(count, granule);
+}
+
+unit_stats nonce_scheduler::stats(unsigned unit) const
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    return stats_[unit];
+}
@@ -0,0 +1,77 @@
+/*
+  This file is part of ethash.
+
+  ethash is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  ethash is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with ethash.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file scheduler.h
+* @date 2026
+*
+* Splits the nonce space between mining units (a device with all its compute
+* units, or the CPU threads). Nonces are handed out in rounds: each round is
+* partitioned into one disjoint range per unit, sized by the unit's measured
+* hashrate, and a unit that drains its range early steals the upper half of
+* the largest range left. Batches are sized so each takes about the same
+* time on every unit.
+*/
+#pragma once
+
+#include <stdint.h>
+#include <mutex>
+#include <vector>
+
+struct nonce_range
+{
+    uint64_t begin;
+    uint64_t end;
+};
+
+struct unit_stats
+{
+    double rate;                  // hashes per second, smoothed; 0 until measured
+    uint64_t hashes;
+    uint64_t batches;
+    uint64_t steals;
+};
+
+class nonce_scheduler
+{
+public:
+    // Hands out [start, limit) in rounds of round_size nonces.
+    nonce_scheduler(unsigned units, uint64_t start, uint64_t limit, uint64_t round_size);
+
+    // Claims the unit's next batch of up to max_count nonces from its own
+    // range, stealing or opening a new round when it is empty. Returns false
+    // once [start, limit) is fully handed out.
+    bool next(unsigned unit, uint32_t max_count, nonce_range& batch);
+
+    // Records hashes completed by the unit over seconds of its wall time.
+    void record(unsigned unit, uint64_t hashes, double seconds);
+
+    // Batch size that keeps the unit busy for about target_seconds, a multiple
+    // of granule within [granule, max_count]; initial until a rate is known.
+    uint32_t batch_size(unsigned unit, double target_seconds, uint32_t initial, uint32_t granule, uint32_t max_count) const;
+
+    unit_stats stats(unsigned unit) const;
+
+private:
+    bool steal(unsigned unit);
+    bool open_round();
+
+    mutable std::mutex mutex_;
+    std::vector<nonce_range> ranges_;
+    std::vector<unit_stats> stats_;
+    uint64_t cursor_;
+    uint64_t limit_;
+    uint64_t round_size_;
+};
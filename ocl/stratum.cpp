@@ -0,0 +1,348 @@
+/*
+  This file is part of ethash.
+
+  ethash is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  ethash is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with ethash.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file stratum.cpp
+* @date 2026
+*/
+
+#include <ctype.h>
+#include <netdb.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <iostream>
+#include <vector>
+#include "stratum.h"
+#include "../c/ethash.h"
+
+// request ids, as eth-proxy clients use them; pushed jobs come with id 0
+static const int ID_LOGIN = 1;
+static const int ID_SUBMIT = 4;
+static const int ID_GET_WORK = 5;
+
+// pause before reconnecting to a server that went away
+static const double RECONNECT_SECONDS = 1;
+
+// epochs searched for a job's seed hash, well past the tabulated sizes
+static const uint32_t MAX_SEED_EPOCHS = 4096;
+
+// The raw value of "key" in a flat JSON object: an array up to its closing
+// bracket, a string without its quotes, anything else up to the next , or }.
+static bool json_value(const std::string& line, const char* key, std::string& value)
+{
+    size_t pos = line.find("\"" + std::string(key) + "\"");
+    if (pos == std::string::npos)
+        return false;
+    pos = line.find_first_not_of(" \t", pos + strlen(key) + 2);
+    if (pos == std::string::npos || line[pos] != ':')
+        return false;
+    pos = line.find_first_not_of(" \t", pos + 1);
+    if (pos == std::string::npos)
+        return false;
+    size_t end;
+    if (line[pos] == '[') {
+        end = line.find(']', pos);
+        if (end == std::string::npos)
+            return false;
+        value = line.substr(pos, end + 1 - pos);
+    } else if (line[pos] == '"') {
+        end = line.find('"', pos + 1);
+        if (end == std::string::npos)
+            return false;
+        value = line.substr(pos + 1, end - pos - 1);
+    } else {
+        end = line.find_first_of(",}", pos);
+        value = line.substr(pos, end == std::string::npos ? std::string::npos : end - pos);
+        value.erase(value.find_last_not_of(" \t\r") + 1);
+    }
+    return true;
+}
+
+// the strings of a JSON array of strings
+static std::vector<std::string> json_strings(const std::string& array)
+{
+    std::vector<std::string> strings;
+    size_t pos = 0;
+    for (;;) {
+        size_t begin = array.find('"', pos);
+        if (begin == std::string::npos)
+            return strings;
+        size_t end = array.find('"', begin + 1);
+        if (end == std::string::npos)
+            return strings;
+        strings.push_back(array.substr(begin + 1, end - begin - 1));
+        pos = end + 1;
+    }
+}
+
+// "0x"-prefixed big-endian hex into size bytes; shorter values are
+// zero-extended on the left, as pools send boundaries
+static bool parse_hex(std::string hex, uint8_t* out, size_t size)
+{
+    if (hex.compare(0, 2, "0x") == 0)
+        hex.erase(0, 2);
+    if (hex.empty() || hex.size() > 2 * size)
+        return false;
+    hex.insert(0, 2 * size - hex.size(), '0');
+    for (size_t i = 0; i != size; ++i) {
+        unsigned byte;
+        if (!isxdigit((unsigned char) hex[2 * i]) || !isxdigit((unsigned char) hex[2 * i + 1])
+                || sscanf(hex.c_str() + 2 * i, "%2x", &byte) != 1)
+            return false;
+        out[i] = (uint8_t) byte;
+    }
+    return true;
+}
+
+static std::string to_hex(const uint8_t* bytes, size_t size)
+{
+    static const char digits[] = "0123456789abcdef";
+    std::string hex = "0x";
+    for (size_t i = 0; i != size; ++i) {
+        hex += digits[bytes[i] >> 4];
+        hex += digits[bytes[i] & 0xf];
+    }
+    return hex;
+}
+
+stratum_client::stratum_client(const std::string& address, job_callback on_job, share_callback on_share) :
+    on_job_(on_job), on_share_(on_share)
+{
+    size_t at = address.find('@');
+    login_ = at == std::string::npos ? "x" : address.substr(0, at);
+    server_ = at == std::string::npos ? address : address.substr(at + 1);
+    memset(seed_, 0, sizeof(seed_));
+    seed_epoch_ = 0;
+}
+
+stratum_client::~stratum_client()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+        if (fd_ >= 0)
+            shutdown(fd_, SHUT_RDWR);     // wakes the reader
+    }
+    wake_.notify_all();
+    if (reader_.joinable())
+        reader_.join();
+}
+
+int stratum_client::connect_server(std::string& error) const
+{
+    if (server_.compare(0, 5, "unix:") == 0) {
+        struct sockaddr_un addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        std::string const path = server_.substr(5);
+        if (path.empty() || path.size() >= sizeof(addr.sun_path)) {
+            error = "bad socket path " + path;
+            return -1;
+        }
+        strcpy(addr.sun_path, path.c_str());
+        int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd >= 0 && connect(fd, (struct sockaddr*) &addr, sizeof(addr)) == 0)
+            return fd;
+        if (fd >= 0)
+            close(fd);
+        error = "unable to connect to " + path;
+        return -1;
+    }
+
+    size_t colon = server_.rfind(':');
+    if (colon == std::string::npos) {
+        error = "work source " + server_ + " is neither unix:<path> nor <host>:<port>";
+        return -1;
+    }
+    std::string const host = server_.substr(0, colon), port = server_.substr(colon + 1);
+    struct addrinfo hints, *found;
+    memset(&hints, 0, sizeof(hints));
+    hints.ai_family = AF_UNSPEC;
+    hints.ai_socktype = SOCK_STREAM;
+    if (getaddrinfo(host.c_str(), port.c_str(), &hints, &found) != 0) {
+        error = "unable to resolve " + server_;
+        return -1;
+    }
+    int fd = -1;
+    for (struct addrinfo* ai = found; ai && fd < 0; ai = ai->ai_next) {
+        fd = socket(ai->ai_family, ai->ai_socktype, ai->ai_protocol);
+        if (fd >= 0 && connect(fd, ai->ai_addr, ai->ai_addrlen) != 0) {
+            close(fd);
+            fd = -1;
+        }
+    }
+    freeaddrinfo(found);
+    if (fd < 0)
+        error = "unable to connect to " + server_;
+    return fd;
+}
+
+bool stratum_client::start(std::string& error)
+{
+    int fd = connect_server(error);
+    if (fd < 0)
+        return false;
+    fd_ = fd;
+    reader_ = std::thread(&stratum_client::run, this, fd);
+    return true;
+}
+
+bool stratum_client::wait_job(stratum_job& job, double seconds)
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    wake_.wait_for(lock, std::chrono::duration<double>(seconds), [this]() { return have_job_ || stop_; });
+    if (!have_job_)
+        return false;
+    job = job_;
+    return true;
+}
+
+// Whole lines only, under mutex_, so submits from several units and the
+// reader's requests never interleave.
+bool stratum_client::send_line(int fd, const std::string& line)
+{
+    std::string const text = line + "\n";
+    for (size_t sent = 0; sent < text.size(); ) {
+        ssize_t n = send(fd, text.data() + sent, text.size() - sent, MSG_NOSIGNAL);
+        if (n <= 0)
+            return false;
+        sent += n;
+    }
+    return true;
+}
+
+bool stratum_client::submit(uint64_t nonce, const uint8_t header[32], const uint8_t mix_hash[32])
+{
+    uint8_t nonce_bytes[8];
+    for (unsigned i = 0; i != 8; ++i)
+        nonce_bytes[i] = (uint8_t) (nonce >> (56 - 8 * i));
+    std::lock_guard<std::mutex> lock(mutex_);
+    return fd_ >= 0 && send_line(fd_, "{\"id\":" + std::to_string(ID_SUBMIT)
+            + ",\"jsonrpc\":\"2.0\",\"method\":\"eth_submitWork\",\"params\":[\"" + to_hex(nonce_bytes, 8)
+            + "\",\"" + to_hex(header, 32) + "\",\"" + to_hex(mix_hash, 32) + "\"]}");
+}
+
+// One connection per iteration: log in, ask for work, then take lines as
+// they come, dated as soon as they are read.
+void stratum_client::run(int fd)
+{
+    for (;;) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            bool const sent = send_line(fd, "{\"id\":" + std::to_string(ID_LOGIN)
+                    + ",\"jsonrpc\":\"2.0\",\"method\":\"eth_submitLogin\",\"params\":[\"" + login_ + "\"]}")
+                    && send_line(fd, "{\"id\":" + std::to_string(ID_GET_WORK)
+                    + ",\"jsonrpc\":\"2.0\",\"method\":\"eth_getWork\",\"params\":[]}");
+            if (sent)
+                std::cout << "stratum: connected to " << server_ << std::endl;
+        }
+
+        std::string pending;
+        char buffer[4096];
+        ssize_t n;
+        while ((n = recv(fd, buffer, sizeof(buffer), 0)) > 0) {
+            auto const received = std::chrono::steady_clock::now();
+            pending.append(buffer, n);
+            size_t end;
+            while ((end = pending.find('\n')) != std::string::npos) {
+                dispatch(pending.substr(0, end), received);
+                pending.erase(0, end + 1);
+            }
+        }
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        fd_ = -1;
+        close(fd);
+        if (stop_)
+            return;
+        std::cout << "stratum: lost " << server_ << ", reconnecting" << std::endl;
+        do {
+            wake_.wait_for(lock, std::chrono::duration<double>(RECONNECT_SECONDS));
+            if (stop_)
+                return;
+            lock.unlock();              // submits fail fast meanwhile
+            std::string error;
+            fd = connect_server(error);
+            lock.lock();
+        } while (fd < 0);
+        if (stop_) {
+            close(fd);
+            return;
+        }
+        fd_ = fd;
+    }
+}
+
+void stratum_client::dispatch(const std::string& line, std::chrono::steady_clock::time_point received)
+{
+    std::string id, result, error;
+    json_value(line, "id", id);
+    bool const has_result = json_value(line, "result", result);
+    bool const failed = json_value(line, "error", error) && error != "null";
+
+    if (id == std::to_string(ID_SUBMIT)) {
+        if (on_share_)
+            on_share_(has_result && result == "true" && !failed);
+        return;
+    }
+    if (id == std::to_string(ID_LOGIN)) {
+        if (!has_result || result != "true")
+            std::cout << "warning: stratum: login refused: " << line << std::endl;
+        return;
+    }
+    if (!has_result || result.empty() || result[0] != '[')
+        return;
+
+    std::vector<std::string> fields = json_strings(result);
+    stratum_job job;
+    uint8_t seed[32];
+    if (fields.size() < 3 || !parse_hex(fields[0], job.header, 32) || !parse_hex(fields[1], seed, 32)
+            || !parse_hex(fields[2], job.boundary, 32)) {
+        std::cout << "warning: stratum: ignoring work " << line << std::endl;
+        return;
+    }
+    job.received = received;
+
+    std::unique_lock<std::mutex> lock(mutex_);
+    if (fields.size() > 3) {
+        job.epoch = (uint32_t) (strtoull(fields[3].c_str(), NULL, 0) / ETHASH_EPOCH_LENGTH);
+    } else if (have_seed_ && memcmp(seed, seed_, 32) == 0) {
+        job.epoch = seed_epoch_;
+    } else {
+        int32_t epoch = ethash_get_seedhash_epoch(seed, MAX_SEED_EPOCHS);
+        if (epoch < 0) {
+            std::cout << "warning: stratum: no epoch has the seed hash of " << line << std::endl;
+            return;
+        }
+        job.epoch = (uint32_t) epoch;
+    }
+    memcpy(seed_, seed, 32);
+    seed_epoch_ = job.epoch;
+    have_seed_ = true;
+    lock.unlock();
+
+    // handed on before wait_job sees it, so the job is in place on return
+    if (on_job_)
+        on_job_(job);
+    lock.lock();
+    job_ = job;
+    have_job_ = true;
+    lock.unlock();
+    wake_.notify_all();
+}
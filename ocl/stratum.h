@@ -0,0 +1,86 @@
+/*
+  This file is part of ethash.
+
+  ethash is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  ethash is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with ethash.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file stratum.h
+* @date 2026
+*
+* Work from a local pool proxy in the line-based JSON-RPC dialect of
+* eth-proxy's stratum mode: the miner logs in with eth_submitLogin and asks
+* once with eth_getWork; from then on the server pushes every new job as an
+* unsolicited result ["0x<header>", "0x<seed>", "0x<boundary>"] (a fourth
+* element, the block number, is optional) and solutions go back with
+* eth_submitWork, answered with true or false. One reader thread per
+* connection, reconnecting when the server goes away.
+*/
+#pragma once
+
+#include <stdint.h>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+
+struct stratum_job
+{
+    uint8_t header[32];
+    uint8_t boundary[32];
+    uint32_t epoch;
+    std::chrono::steady_clock::time_point received;   // the line came off the socket
+};
+
+class stratum_client
+{
+public:
+    typedef std::function<void(const stratum_job&)> job_callback;
+    typedef std::function<void(bool accepted)> share_callback;
+
+    // address is "[login@]unix:<path>" or "[login@]<host>:<port>"; on_job runs
+    // on the reader thread for every job, on_share for every answer to submit.
+    stratum_client(const std::string& address, job_callback on_job, share_callback on_share);
+    ~stratum_client();
+
+    // Connects and starts the reader; false with a reason when the first
+    // connection fails.
+    bool start(std::string& error);
+
+    // Waits up to seconds for a job to have arrived and returns the latest.
+    bool wait_job(stratum_job& job, double seconds);
+
+    // Sends a solution for header; false when not connected.
+    bool submit(uint64_t nonce, const uint8_t header[32], const uint8_t mix_hash[32]);
+
+private:
+    int connect_server(std::string& error) const;
+    bool send_line(int fd, const std::string& line);
+    void run(int fd);
+    void dispatch(const std::string& line, std::chrono::steady_clock::time_point received);
+
+    std::string login_, server_;
+    job_callback on_job_;
+    share_callback on_share_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    int fd_ = -1;
+    bool stop_ = false;
+    bool have_job_ = false;
+    stratum_job job_;
+    uint8_t seed_[32];                  // last seen, to skip the epoch search
+    uint32_t seed_epoch_;
+    bool have_seed_ = false;
+    std::thread reader_;
+};
@@ -0,0 +1,269 @@
+/*
+  This file is part of ethash.
+
+  ethash is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  ethash is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with ethash.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file stratum_test.cpp
+* @date 2026
+*
+* stratum_client against a scripted pool on a unix socket: login and
+* getWork on connect, two pushed jobs (one found by its seed hash, one by
+* its block number, spaced and with a short boundary), which of the results
+* on either job the feed counts stale, submits answered true and false, and
+* a reconnect after the pool drops the connection. Exits non-zero on the
+* first failed check.
+*
+*   g++ -std=c++14 -O2 -pthread stratum_test.cpp stratum.cpp ../c/ethash.c -o stratum_test
+*/
+
+#include <poll.h>
+#include <stdio.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <atomic>
+#include <iostream>
+#include <string>
+#include "backend.h"
+#include "stratum.h"
+#include "../c/ethash.h"
+
+// longest wait for any one step, well past the client's reconnect pause
+static const int STEP_MS = 5000;
+
+#define CHECK(cond) \
+    do { \
+        if (!(cond)) { \
+            std::cout << "stratum test failed: " << #cond << " (line " << __LINE__ << ")" << std::endl; \
+            return 1; \
+        } \
+    } while (0)
+
+namespace
+{
+
+// The server end: one listening socket, one client at a time, whole lines.
+class fake_pool
+{
+public:
+    explicit fake_pool(const std::string& path) : path_(path)
+    {
+        struct sockaddr_un addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+        unlink(path.c_str());
+        listen_fd_ = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (listen_fd_ >= 0 && (bind(listen_fd_, (struct sockaddr*) &addr, sizeof(addr)) != 0 || listen(listen_fd_, 1) != 0)) {
+            close(listen_fd_);
+            listen_fd_ = -1;
+        }
+    }
+
+    ~fake_pool()
+    {
+        drop();
+        if (listen_fd_ >= 0)
+            close(listen_fd_);
+        unlink(path_.c_str());
+    }
+
+    bool listening() const { return listen_fd_ >= 0; }
+
+    bool accept_client()
+    {
+        if (!ready(listen_fd_))
+            return false;
+        client_fd_ = accept(listen_fd_, NULL, NULL);
+        pending_.clear();
+        return client_fd_ >= 0;
+    }
+
+    // closes the connection, as a pool restart would
+    void drop()
+    {
+        if (client_fd_ >= 0)
+            close(client_fd_);
+        client_fd_ = -1;
+    }
+
+    bool read_line(std::string& line)
+    {
+        size_t end;
+        while ((end = pending_.find('\n')) == std::string::npos) {
+            char buffer[1024];
+            ssize_t n = ready(client_fd_) ? recv(client_fd_, buffer, sizeof(buffer), 0) : -1;
+            if (n <= 0)
+                return false;
+            pending_.append(buffer, n);
+        }
+        line = pending_.substr(0, end);
+        pending_.erase(0, end + 1);
+        return true;
+    }
+
+    bool send_line(const std::string& line)
+    {
+        std::string const text = line + "\n";
+        return send(client_fd_, text.data(), text.size(), MSG_NOSIGNAL) == (ssize_t) text.size();
+    }
+
+private:
+    static bool ready(int fd)
+    {
+        struct pollfd p = {fd, POLLIN, 0};
+        return fd >= 0 && poll(&p, 1, STEP_MS) == 1;
+    }
+
+    std::string path_;
+    int listen_fd_ = -1, client_fd_ = -1;
+    std::string pending_;
+};
+
+std::string hex(const uint8_t* bytes, size_t size)
+{
+    static const char digits[] = "0123456789abcdef";
+    std::string out;
+    for (size_t i = 0; i != size; ++i) {
+        out += digits[bytes[i] >> 4];
+        out += digits[bytes[i] & 0xf];
+    }
+    return out;
+}
+
+// the job the pool pushes; block is the optional fourth element, 0 for none
+std::string job_line(const uint8_t header[32], const uint8_t seed[32], const std::string& boundary, uint32_t block)
+{
+    std::string line = "{ \"id\" : 0, \"jsonrpc\" : \"2.0\", \"result\" : [ \"0x" + hex(header, 32) + "\", \"0x"
+        + hex(seed, 32) + "\", \"" + boundary + "\"";
+    if (block) {
+        char number[16];
+        snprintf(number, sizeof(number), "0x%x", block);
+        line += ", \"" + std::string(number) + "\"";
+    }
+    return line + " ] }";
+}
+
+// login and getWork, in that order, as every connection starts
+bool handshake(fake_pool& pool, const std::string& login)
+{
+    std::string line;
+    if (!pool.accept_client() || !pool.read_line(line) || line.find("\"eth_submitLogin\"") == std::string::npos
+            || line.find("\"" + login + "\"") == std::string::npos)
+        return false;
+    if (!pool.read_line(line) || line.find("\"eth_getWork\"") == std::string::npos)
+        return false;
+    return pool.send_line("{\"id\":1,\"jsonrpc\":\"2.0\",\"result\":true}");
+}
+
+// the feed's view once a result of work comes back, as report() in pow.cpp
+// takes it
+bool is_stale(const work_feed& feed, uint64_t generation)
+{
+    return generation != feed.get().generation;
+}
+
+}
+
+int main()
+{
+    std::string const path = "/tmp/stratum_test." + std::to_string(getpid()) + ".sock";
+    fake_pool pool(path);
+    CHECK(pool.listening());
+
+    work_package initial = work_package();
+    work_feed feed(initial);
+    std::atomic<unsigned> jobs{0}, accepted{0}, rejected{0};
+    stratum_client client("miner@unix:" + path,
+        [&](const stratum_job& job) { feed.update(job.header, job.boundary, &job.epoch, job.received); ++jobs; },
+        [&](bool ok) { ++(ok ? accepted : rejected); });
+    std::string error;
+    CHECK(client.start(error));
+    CHECK(handshake(pool, "miner"));
+
+    // job 1: the epoch comes from the seed hash alone; the boundary is short
+    // and zero-extended on the left
+    uint8_t header1[32], header2[32], seed1[32];
+    for (unsigned i = 0; i != 32; ++i) {
+        header1[i] = (uint8_t) i;
+        header2[i] = (uint8_t) (0xff - i);
+    }
+    ethash_get_seedhash(seed1, ETHASH_EPOCH_LENGTH);
+    CHECK(pool.send_line(job_line(header1, seed1, "0x00000000ffff", 0)));
+    stratum_job job;
+    CHECK(client.wait_job(job, STEP_MS / 1000.0));
+    CHECK(memcmp(job.header, header1, 32) == 0);
+    CHECK(job.epoch == 1);
+    uint8_t boundary1[32] = {0};
+    boundary1[30] = boundary1[31] = 0xff;
+    CHECK(memcmp(job.boundary, boundary1, 32) == 0);
+    uint64_t const generation1 = feed.get().generation;
+    CHECK(generation1 == 1 && feed.get().epoch == 1);
+
+    // a share on job 1, accepted
+    std::string line;
+    uint8_t mix[32];
+    memset(mix, 0xab, sizeof(mix));
+    CHECK(client.submit(0x0102030405060708ULL, header1, mix));
+    CHECK(pool.read_line(line));
+    CHECK(line.find("\"eth_submitWork\"") != std::string::npos);
+    CHECK(line.find("\"0x0102030405060708\"") != std::string::npos);
+    CHECK(line.find("\"0x" + hex(header1, 32) + "\"") != std::string::npos);
+    CHECK(line.find("\"0x" + hex(mix, 32) + "\"") != std::string::npos);
+    CHECK(pool.send_line("{\"id\":4,\"jsonrpc\":\"2.0\",\"result\":true}"));
+
+    // job 2: a new seed, with the block number to take the epoch from
+    uint8_t seed2[32];
+    ethash_get_seedhash(seed2, 2 * ETHASH_EPOCH_LENGTH);
+    CHECK(pool.send_line(job_line(header2, seed2, "0x" + std::string(64, 'f'), 2 * ETHASH_EPOCH_LENGTH + 5)));
+    for (int waited = 0; jobs < 2 && waited < STEP_MS; waited += 10)
+        usleep(10 * 1000);
+    CHECK(jobs == 2);
+    uint64_t const generation2 = feed.get().generation;
+    CHECK(generation2 == 2 && feed.get().epoch == 2);
+
+    // results of batches queued on either job: the first is stale now
+    uint64_t const results[] = {generation1, generation2, generation2};
+    unsigned stale = 0, fresh = 0;
+    for (uint64_t generation : results)
+        ++(is_stale(feed, generation) ? stale : fresh);
+    CHECK(stale == 1 && fresh == 2);
+
+    // a share on each job; the stale one is refused
+    CHECK(client.submit(1, header1, mix) && client.submit(2, header2, mix));
+    CHECK(pool.read_line(line) && line.find("\"0x" + hex(header1, 32) + "\"") != std::string::npos);
+    CHECK(pool.send_line("{\"id\":4,\"jsonrpc\":\"2.0\",\"result\":false,\"error\":{\"code\":23,\"message\":\"stale\"}}"));
+    CHECK(pool.read_line(line) && line.find("\"0x" + hex(header2, 32) + "\"") != std::string::npos);
+    CHECK(pool.send_line("{\"id\":4,\"jsonrpc\":\"2.0\",\"result\":true}"));
+    for (int waited = 0; accepted + rejected < 3 && waited < STEP_MS; waited += 10)
+        usleep(10 * 1000);
+    CHECK(accepted == 2 && rejected == 1);
+
+    // the pool goes away; the client logs in again and takes the next job,
+    // back on the first seed
+    pool.drop();
+    CHECK(handshake(pool, "miner"));
+    CHECK(pool.send_line(job_line(header1, seed1, "0xffff", 0)));
+    for (int waited = 0; jobs < 3 && waited < STEP_MS; waited += 10)
+        usleep(10 * 1000);
+    CHECK(jobs == 3);
+    CHECK(feed.get().generation == 3 && feed.get().epoch == 1);
+    CHECK(is_stale(feed, generation2));
+    CHECK(client.submit(3, header1, mix));
+    CHECK(pool.read_line(line) && line.find("\"eth_submitWork\"") != std::string::npos);
+
+    std::cout << "stratum test passed" << std::endl;
+    return 0;
+}
@@ -0,0 +1,331 @@
+/*
+  This file is part of ethash.
+
+  ethash is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  ethash is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with ethash.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file telemetry.cpp
+* @date 2026
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <algorithm>
+#include <sstream>
+#include "telemetry.h"
+
+telemetry::telemetry(unsigned units) :
+    start_(std::chrono::steady_clock::now()), last_sample_(start_),
+    last_hashes_(units), last_thread_hashes_(units)
+{
+    current_.uptime_seconds = 0;
+    current_.interval_seconds = 0;
+    current_.epoch = 0;
+    current_.dag_prepare_seconds = 0;
+    current_.shares_accepted = current_.shares_rejected = 0;
+    current_.units.resize(units);
+    for (unsigned i = 0; i != units; ++i) {
+        unit_telemetry& unit = current_.units[i];
+        unit.hashes = unit.batches = unit.solutions = unit.stale = unit.rejected = 0;
+        unit.device_seconds = unit.transfer_seconds = unit.epoch_load_seconds = 0;
+        unit.jobs = 0;
+        unit.job_latency_seconds = unit.job_latency_seconds_total = unit.job_latency_max_seconds = 0;
+        unit.hashes_per_second = unit.dag_bytes_per_second = 0;
+    }
+}
+
+void telemetry::set_unit_name(unsigned unit, const std::string& name)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    current_.units[unit].name = name;
+}
+
+void telemetry::record_dag_prepare(uint32_t epoch, double seconds)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    current_.epoch = epoch;
+    current_.dag_prepare_seconds = seconds;
+}
+
+void telemetry::record_epoch_load(unsigned unit, double seconds)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    current_.units[unit].epoch_load_seconds = seconds;
+}
+
+void telemetry::record_batch(unsigned unit, const search_result& result)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    unit_telemetry& stats = current_.units[unit];
+    stats.hashes += result.hashed;
+    stats.batches++;
+    stats.device_seconds += result.device_seconds;
+    stats.transfer_seconds += result.transfer_seconds;
+}
+
+void telemetry::record_solution(unsigned unit, bool stale, bool rejected)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    unit_telemetry& stats = current_.units[unit];
+    stats.solutions++;
+    stats.stale += stale;
+    stats.rejected += rejected;
+}
+
+void telemetry::record_job_start(unsigned unit, double latency_seconds)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    unit_telemetry& stats = current_.units[unit];
+    stats.jobs++;
+    stats.job_latency_seconds = latency_seconds;
+    stats.job_latency_seconds_total += latency_seconds;
+    stats.job_latency_max_seconds = std::max(stats.job_latency_max_seconds, latency_seconds);
+}
+
+void telemetry::record_share(bool accepted)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (accepted)
+        current_.shares_accepted++;
+    else
+        current_.shares_rejected++;
+}
+
+void telemetry::record_threads(unsigned unit, const std::vector<uint64_t>& thread_hashes)
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    current_.units[unit].thread_hashes = thread_hashes;
+}
+
+telemetry_sample telemetry::sample()
+{
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto now = std::chrono::steady_clock::now();
+    double const interval = std::chrono::duration<double>(now - last_sample_).count();
+    current_.uptime_seconds = std::chrono::duration<double>(now - start_).count();
+    current_.interval_seconds = interval;
+    last_sample_ = now;
+    for (unsigned i = 0; i != current_.units.size(); ++i) {
+        unit_telemetry& unit = current_.units[i];
+        unit.hashes_per_second = interval > 0 ? (unit.hashes - last_hashes_[i]) / interval : 0;
+        last_hashes_[i] = unit.hashes;
+        unit.dag_bytes_per_second = unit.device_seconds > 0
+                ? unit.hashes * (double) ETHASH_DAG_BYTES_PER_HASH / unit.device_seconds : 0;
+        std::vector<uint64_t>& last = last_thread_hashes_[i];
+        last.resize(unit.thread_hashes.size());
+        unit.thread_hashes_per_second.resize(unit.thread_hashes.size());
+        for (unsigned t = 0; t != unit.thread_hashes.size(); ++t) {
+            unit.thread_hashes_per_second[t] = interval > 0 ? (unit.thread_hashes[t] - last[t]) / interval : 0;
+            last[t] = unit.thread_hashes[t];
+        }
+    }
+    return current_;
+}
+
+// a label value in the text format: backslash, " and newline escaped
+static std::string label_value(const std::string& text)
+{
+    std::string out;
+    for (char c : text) {
+        if (c == '\n')
+            out += "\\n";
+        else if (c == '\\' || c == '"')
+            out.append(1, '\\').append(1, c);
+        else
+            out += c;
+    }
+    return out;
+}
+
+std::string telemetry_prometheus(const telemetry_sample& sample)
+{
+    std::ostringstream out;
+    out.precision(15);      // counters stay exact integers up to 10^15
+    out << "# TYPE ethash_uptime_seconds gauge\nethash_uptime_seconds " << sample.uptime_seconds << "\n";
+    out << "# TYPE ethash_epoch gauge\nethash_epoch " << sample.epoch << "\n";
+    out << "# TYPE ethash_dag_prepare_seconds gauge\nethash_dag_prepare_seconds " << sample.dag_prepare_seconds << "\n";
+    out << "# TYPE ethash_shares_accepted_total counter\nethash_shares_accepted_total " << sample.shares_accepted << "\n";
+    out << "# TYPE ethash_shares_rejected_total counter\nethash_shares_rejected_total " << sample.shares_rejected << "\n";
+
+    struct metric
+    {
+        const char* name;
+        const char* type;
+        const char* help;
+        double (*value)(const unit_telemetry&);
+    };
+    static const metric metrics[] = {
+        {"ethash_hashes_total", "counter", "nonces hashed",
+            [](const unit_telemetry& u) { return (double) u.hashes; }},
+        {"ethash_batches_total", "counter", "batches completed",
+            [](const unit_telemetry& u) { return (double) u.batches; }},
+        {"ethash_solutions_total", "counter", "solutions found",
+            [](const unit_telemetry& u) { return (double) u.solutions; }},
+        {"ethash_solutions_stale_total", "counter", "solutions found for replaced work",
+            [](const unit_telemetry& u) { return (double) u.stale; }},
+        {"ethash_solutions_rejected_total", "counter", "solutions not matching the host DAG",
+            [](const unit_telemetry& u) { return (double) u.rejected; }},
+        {"ethash_device_seconds_total", "counter", "kernel execution time",
+            [](const unit_telemetry& u) { return u.device_seconds; }},
+        {"ethash_transfer_seconds_total", "counter", "host-device transfer time",
+            [](const unit_telemetry& u) { return u.transfer_seconds; }},
+        {"ethash_epoch_load_seconds", "gauge", "time to load the current DAG onto the unit",
+            [](const unit_telemetry& u) { return u.epoch_load_seconds; }},
+        {"ethash_hashrate", "gauge", "hashes per second over the last interval",
+            [](const unit_telemetry& u) { return u.hashes_per_second; }},
+        {"ethash_dag_bandwidth_bytes_per_second", "gauge", "DAG bytes read per second of kernel time",
+            [](const unit_telemetry& u) { return u.dag_bytes_per_second; }},
+        {"ethash_jobs_total", "counter", "work packages the unit started hashing",
+            [](const unit_telemetry& u) { return (double) u.jobs; }},
+        {"ethash_job_latency_seconds", "gauge", "work receipt to the unit's first hash of it, last job",
+            [](const unit_telemetry& u) { return u.job_latency_seconds; }},
+        {"ethash_job_latency_seconds_total", "counter", "work receipt to first hash, summed over jobs",
+            [](const unit_telemetry& u) { return u.job_latency_seconds_total; }},
+        {"ethash_job_latency_max_seconds", "gauge", "work receipt to first hash, slowest job",
+            [](const unit_telemetry& u) { return u.job_latency_max_seconds; }},
+    };
+    std::vector<std::string> labels(sample.units.size());
+    for (unsigned i = 0; i != sample.units.size(); ++i)
+        labels[i] = label_value(sample.units[i].name);
+    for (const metric& m : metrics) {
+        out << "# HELP " << m.name << " " << m.help << "\n";
+        out << "# TYPE " << m.name << " " << m.type << "\n";
+        for (unsigned i = 0; i != sample.units.size(); ++i)
+            out << m.name << "{unit=\"" << labels[i] << "\"} " << m.value(sample.units[i]) << "\n";
+    }
+    out << "# HELP ethash_thread_hashrate hashes per second of one worker thread over the last interval\n";
+    out << "# TYPE ethash_thread_hashrate gauge\n";
+    for (unsigned i = 0; i != sample.units.size(); ++i) {
+        const unit_telemetry& unit = sample.units[i];
+        for (unsigned t = 0; t != unit.thread_hashes_per_second.size(); ++t)
+            out << "ethash_thread_hashrate{unit=\"" << labels[i] << "\",thread=\"" << t << "\"} " << unit.thread_hashes_per_second[t] << "\n";
+    }
+    return out.str();
+}
+
+telemetry_reporter::telemetry_reporter(telemetry& source, double interval_seconds, const std::string& target, callback on_sample) :
+    source_(source), interval_seconds_(interval_seconds), target_(target), on_sample_(on_sample)
+{
+}
+
+telemetry_reporter::~telemetry_reporter()
+{
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        stop_ = true;
+    }
+    wake_.notify_all();
+    if (sampler_.joinable())
+        sampler_.join();
+    if (listen_fd_ >= 0) {
+        shutdown(listen_fd_, SHUT_RDWR);     // wakes accept
+        if (server_.joinable())
+            server_.join();
+        close(listen_fd_);
+        unlink(target_.c_str() + 5);
+    }
+}
+
+bool telemetry_reporter::start(std::string& error)
+{
+    bool ok = true;
+    if (target_.compare(0, 5, "unix:") == 0) {
+        struct sockaddr_un addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sun_family = AF_UNIX;
+        std::string const path = target_.substr(5);
+        if (path.empty() || path.size() >= sizeof(addr.sun_path)) {
+            error = "bad socket path " + path;
+            ok = false;
+        } else {
+            strcpy(addr.sun_path, path.c_str());
+            unlink(path.c_str());
+            listen_fd_ = socket(AF_UNIX, SOCK_STREAM, 0);
+            if (listen_fd_ < 0 || bind(listen_fd_, (struct sockaddr*) &addr, sizeof(addr)) != 0 || listen(listen_fd_, 4) != 0) {
+                error = "unable to listen on " + path;
+                if (listen_fd_ >= 0)
+                    close(listen_fd_);
+                listen_fd_ = -1;
+                ok = false;
+            } else {
+                server_ = std::thread(&telemetry_reporter::serve, this);
+            }
+        }
+    }
+    sampler_ = std::thread(&telemetry_reporter::run, this);
+    return ok;
+}
+
+void telemetry_reporter::run()
+{
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (!stop_) {
+        wake_.wait_for(lock, std::chrono::duration<double>(interval_seconds_));
+        if (stop_)
+            break;
+        lock.unlock();
+        telemetry_sample const sample = source_.sample();
+        if (on_sample_)
+            on_sample_(sample);
+        if (!target_.empty())
+            publish(telemetry_prometheus(sample));
+        lock.lock();
+    }
+}
+
+// Each client gets the latest text and is disconnected.
+void telemetry_reporter::serve()
+{
+    for (;;) {
+        int client = accept(listen_fd_, NULL, NULL);
+        if (client < 0)
+            return;
+        std::string text;
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            text = latest_;
+        }
+        size_t sent = 0;
+        while (sent < text.size()) {
+            ssize_t n = send(client, text.data() + sent, text.size() - sent, MSG_NOSIGNAL);
+            if (n <= 0)
+                break;
+            sent += (size_t) n;
+        }
+        close(client);
+    }
+}
+
+void telemetry_reporter::publish(const std::string& text)
+{
+    if (listen_fd_ >= 0) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        latest_ = text;
+        return;
+    }
+    if (target_.compare(0, 5, "unix:") == 0)
+        return;                             // the socket could not listen; start said so
+    // written beside the target and renamed, so scrapers never see half a file
+    std::string const tmp = target_ + ".tmp";
+    FILE* file = fopen(tmp.c_str(), "w");
+    if (!file)
+        return;
+    bool const written = fwrite(text.data(), 1, text.size(), file) == text.size();
+    if (fclose(file) == 0 && written)
+        rename(tmp.c_str(), target_.c_str());
+    else
+        unlink(tmp.c_str());
+}
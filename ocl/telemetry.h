@@ -0,0 +1,131 @@
+/*
+  This file is part of ethash.
+
+  ethash is free software: you can redistribute it and/or modify
+  it under the terms of the GNU General Public License as published by
+  the Free Software Foundation, either version 3 of the License, or
+  (at your option) any later version.
+
+  ethash is distributed in the hope that it will be useful,
+  but WITHOUT ANY WARRANTY; without even the implied warranty of
+  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+  GNU General Public License for more details.
+
+  You should have received a copy of the GNU General Public License
+  along with ethash.  If not, see <http://www.gnu.org/licenses/>.
+*/
+/** @file telemetry.h
+* @date 2026
+*
+* Miner counters, updated once per completed batch so the hot path only
+* pays for a mutex every few hundred milliseconds. A reporter thread samples
+* them periodically, derives rates over the interval, hands the sample to a
+* callback and publishes it as Prometheus text to a file or a unix socket.
+*/
+#pragma once
+
+#include <stdint.h>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "backend.h"
+
+struct unit_telemetry
+{
+    std::string name;
+    uint64_t hashes;
+    uint64_t batches;
+    uint64_t solutions;                 // hits reported by the device
+    uint64_t stale;                     // of those, found for replaced work
+    uint64_t rejected;                  // of those, not matching the host DAG
+    double device_seconds;              // kernel execution, from event profiling
+    double transfer_seconds;            // host <-> device copies, same source
+    double epoch_load_seconds;          // last load_epoch, DAG upload included
+    uint64_t jobs;                      // work packages the unit started on
+    double job_latency_seconds;         // receipt to first hash, last job
+    double job_latency_seconds_total;   // the same, summed over jobs
+    double job_latency_max_seconds;
+    std::vector<uint64_t> thread_hashes;
+
+    // over the last sampling interval
+    double hashes_per_second;
+    std::vector<double> thread_hashes_per_second;
+    // DAG bytes read per second of kernel time, cumulative
+    double dag_bytes_per_second;
+};
+
+struct telemetry_sample
+{
+    double uptime_seconds;
+    double interval_seconds;
+    uint32_t epoch;
+    double dag_prepare_seconds;         // mapping, or generating, the epoch's DAG
+    uint64_t shares_accepted;           // answers of the work source to submits
+    uint64_t shares_rejected;
+    std::vector<unit_telemetry> units;
+};
+
+class telemetry
+{
+public:
+    explicit telemetry(unsigned units);
+
+    void set_unit_name(unsigned unit, const std::string& name);
+    void record_dag_prepare(uint32_t epoch, double seconds);
+    void record_epoch_load(unsigned unit, double seconds);
+    void record_batch(unsigned unit, const search_result& result);
+    void record_solution(unsigned unit, bool stale, bool rejected);
+    void record_job_start(unsigned unit, double latency_seconds);
+    void record_share(bool accepted);
+    void record_threads(unsigned unit, const std::vector<uint64_t>& thread_hashes);
+
+    // Cumulative counters plus rates since the previous sample.
+    telemetry_sample sample();
+
+private:
+    std::mutex mutex_;
+    std::chrono::steady_clock::time_point start_, last_sample_;
+    telemetry_sample current_;
+    std::vector<uint64_t> last_hashes_;
+    std::vector<std::vector<uint64_t>> last_thread_hashes_;
+};
+
+// Prometheus text exposition format, one line per metric and unit.
+std::string telemetry_prometheus(const telemetry_sample& sample);
+
+// Samples every interval_seconds on its own thread, calls callback with each
+// sample and, when target is set, publishes the Prometheus text: to the file
+// target (replaced atomically), or for "unix:<path>" to every client that
+// connects to that socket.
+class telemetry_reporter
+{
+public:
+    typedef std::function<void(const telemetry_sample&)> callback;
+
+    telemetry_reporter(telemetry& source, double interval_seconds, const std::string& target, callback on_sample);
+    ~telemetry_reporter();
+
+    // false with a reason when the target cannot be opened; the callback
+    // still runs
+    bool start(std::string& error);
+
+private:
+    void run();
+    void serve();
+    void publish(const std::string& text);
+
+    telemetry& source_;
+    double interval_seconds_;
+    std::string target_;
+    callback on_sample_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    bool stop_ = false;
+    std::string latest_;
+    int listen_fd_ = -1;
+    std::thread sampler_, server_;
+};